@@ -45,6 +45,7 @@ namespace ams::impl {
     AMS_DEFINE_SYSTEM_THREAD(21, ncm, MainWaitThreads);
     AMS_DEFINE_SYSTEM_THREAD(21, ncm, ContentManagerServerIpcSession);
     AMS_DEFINE_SYSTEM_THREAD(21, ncm, LocationResolverServerIpcSession);
+    AMS_DEFINE_SYSTEM_THREAD(21, ncm, PlaceHolderWriter);
 
     /* FS. */
     AMS_DEFINE_SYSTEM_THREAD(11, sdmmc, DeviceDetector);
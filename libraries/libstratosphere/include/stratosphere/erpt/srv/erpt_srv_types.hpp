@@ -24,6 +24,7 @@ namespace ams::erpt::srv {
 
     constexpr inline const char ReportStoragePath[]             = "save";
     constexpr inline const char JournalFileName[]               = "save:/journal";
+    constexpr inline const char JournalLogFileName[]            = "save:/journal_log";
     constexpr inline const char ForcedShutdownContextFileName[] = "save:/forced-shutdown";
 
     constexpr size_t ReportFileNameLength = 64;
@@ -125,7 +125,7 @@ namespace ams::fssystem {
                     s32 m_external_attr_info_count;
                     s32 m_cache_count_min;
                     size_t m_cache_size_min;
-                    size_t m_total_cache_size;
+                    std::atomic<size_t> m_total_cache_size;
                     CacheHandle m_current_handle;
                 public:
                     static constexpr size_t QueryWorkBufferSize(s32 max_cache_count) {
@@ -191,10 +191,13 @@ namespace ams::fssystem {
             BuddyHeap m_buddy_heap;
             CacheHandleTable m_cache_handle_table;
             size_t m_total_size;
-            size_t m_peak_free_size;
-            size_t m_peak_total_allocatable_size;
-            size_t m_retried_count;
-            mutable os::SdkRecursiveMutex m_mutex;
+            std::atomic<size_t> m_free_size;
+            std::atomic<size_t> m_peak_free_size;
+            std::atomic<size_t> m_total_allocatable_size;
+            std::atomic<size_t> m_peak_total_allocatable_size;
+            std::atomic<size_t> m_retried_count;
+            os::SdkMutex m_heap_mutex;
+            os::SdkMutex m_table_mutex;
         public:
             static constexpr size_t QueryWorkBufferSize(s32 max_cache_count, s32 max_order) {
                 const auto buddy_size = FileSystemBuddyHeap::QueryWorkBufferSize(max_order);
@@ -202,7 +205,7 @@ namespace ams::fssystem {
                 return buddy_size + table_size;
             }
         public:
-            FileSystemBufferManager() : m_total_size(), m_peak_free_size(), m_peak_total_allocatable_size(), m_retried_count(), m_mutex() { /* ... */ }
+            FileSystemBufferManager() : m_total_size(), m_free_size(), m_peak_free_size(), m_total_allocatable_size(), m_peak_total_allocatable_size(), m_retried_count(), m_heap_mutex(), m_table_mutex() { /* ... */ }
 
             virtual ~FileSystemBufferManager() { /* ... */ }
 
@@ -212,7 +215,9 @@ namespace ams::fssystem {
                 R_TRY(m_buddy_heap.Initialize(address, buffer_size, block_size));
 
                 m_total_size                  = m_buddy_heap.GetTotalFreeSize();
+                m_free_size                   = m_total_size;
                 m_peak_free_size              = m_total_size;
+                m_total_allocatable_size      = m_total_size;
                 m_peak_total_allocatable_size = m_total_size;
 
                 return ResultSuccess();
@@ -224,7 +229,9 @@ namespace ams::fssystem {
                 R_TRY(m_buddy_heap.Initialize(address, buffer_size, block_size, max_order));
 
                 m_total_size                  = m_buddy_heap.GetTotalFreeSize();
+                m_free_size                   = m_total_size;
                 m_peak_free_size              = m_total_size;
+                m_total_allocatable_size      = m_total_size;
                 m_peak_total_allocatable_size = m_total_size;
 
                 return ResultSuccess();
@@ -241,7 +248,9 @@ namespace ams::fssystem {
                 R_TRY(m_buddy_heap.Initialize(address, buffer_size, block_size, buddy_buffer, buddy_size));
 
                 m_total_size                  = m_buddy_heap.GetTotalFreeSize();
+                m_free_size                   = m_total_size;
                 m_peak_free_size              = m_total_size;
+                m_total_allocatable_size      = m_total_size;
                 m_peak_total_allocatable_size = m_total_size;
 
                 return ResultSuccess();
@@ -258,7 +267,9 @@ namespace ams::fssystem {
                 R_TRY(m_buddy_heap.Initialize(address, buffer_size, block_size, max_order, buddy_buffer, buddy_size));
 
                 m_total_size                  = m_buddy_heap.GetTotalFreeSize();
+                m_free_size                   = m_total_size;
                 m_peak_free_size              = m_total_size;
+                m_total_allocatable_size      = m_total_size;
                 m_peak_total_allocatable_size = m_total_size;
 
                 return ResultSuccess();
@@ -290,6 +301,11 @@ namespace ams::fssystem {
             virtual size_t GetRetriedCountImpl() const override;
 
             virtual void ClearPeakImpl() override;
+        private:
+            void UpdateFreeSize();
+            void DeallocateEvictedBuffer(uintptr_t address, size_t size);
+
+            static void UpdatePeak(std::atomic<size_t> &peak, size_t size);
     };
 
 }
@@ -89,6 +89,9 @@ namespace ams::fssystem {
 
             bool IsInitialized() const { return m_table.IsInitialized(); }
 
+            void EnableNodeCache(IBufferManager *buffer_manager) { m_table.EnableNodeCache(buffer_manager); }
+            void GetNodeCacheStatistics(BucketTree::NodeCacheStatistics *out) const { m_table.GetNodeCacheStatistics(out); }
+
             virtual Result Read(s64 offset, void *buffer, size_t size) override;
             virtual Result OperateRange(void *dst, size_t dst_size, fs::OperationId op_id, s64 offset, s64 size, const void *src, size_t src_size) override;
 
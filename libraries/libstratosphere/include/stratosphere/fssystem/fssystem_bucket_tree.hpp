@@ -15,7 +15,9 @@
  */
 #pragma once
 #include <vapours.hpp>
+#include <stratosphere/os.hpp>
 #include <stratosphere/fs/fs_substorage.hpp>
+#include <stratosphere/fssystem/buffers/fssystem_i_buffer_manager.hpp>
 
 namespace ams::fssystem {
 
@@ -28,9 +30,18 @@ namespace ams::fssystem {
 
             static constexpr size_t NodeSizeMin = 1_KB;
             static constexpr size_t NodeSizeMax = 512_KB;
+
+            /* NOTE: Each tree caches at most this many nodes, and at most 1/NodeCacheBufferManagerShareDivisor of the buffer manager's memory. */
+            static constexpr s32 NodeCacheEntryCountMax                = 64;
+            static constexpr size_t NodeCacheBufferManagerShareDivisor = 16;
         public:
             class Visitor;
 
+            struct NodeCacheStatistics {
+                u64 hit_count;
+                u64 miss_count;
+            };
+
             struct Header {
                 u32 magic;
                 u32 version;
@@ -149,6 +160,13 @@ namespace ams::fssystem {
                         return m_allocator;
                     }
             };
+
+            struct NodeCacheEntry {
+                s64 key;
+                IBufferManager::CacheHandle handle;
+            };
+
+            static constexpr s64 InvalidNodeCacheKey = -1;
         private:
             static constexpr s32 GetEntryCount(size_t node_size, size_t entry_size) {
                 return static_cast<s32>((node_size - sizeof(NodeHeader)) / entry_size);
@@ -215,8 +233,14 @@ namespace ams::fssystem {
             s32 m_entry_set_count;
             s64 m_start_offset;
             s64 m_end_offset;
+            IBufferManager *m_buffer_manager;
+            NodeCacheEntry *m_node_cache_entries;
+            s32 m_node_cache_entry_count;
+            mutable os::SdkMutex m_node_cache_mutex;
+            mutable std::atomic<u64> m_node_cache_hit_count;
+            mutable std::atomic<u64> m_node_cache_miss_count;
         public:
-            BucketTree() : m_node_storage(), m_entry_storage(), m_node_l1(), m_node_size(), m_entry_size(), m_entry_count(), m_offset_count(), m_entry_set_count(), m_start_offset(), m_end_offset() { /* ... */ }
+            BucketTree() : m_node_storage(), m_entry_storage(), m_node_l1(), m_node_size(), m_entry_size(), m_entry_count(), m_offset_count(), m_entry_set_count(), m_start_offset(), m_end_offset(), m_buffer_manager(), m_node_cache_entries(), m_node_cache_entry_count(), m_node_cache_mutex(), m_node_cache_hit_count(), m_node_cache_miss_count() { /* ... */ }
             ~BucketTree() { this->Finalize(); }
 
             Result Initialize(IAllocator *allocator, fs::SubStorage node_storage, fs::SubStorage entry_storage, size_t node_size, size_t entry_size, s32 entry_count);
@@ -229,6 +253,9 @@ namespace ams::fssystem {
             Result Find(Visitor *visitor, s64 virtual_address) const;
             Result InvalidateCache();
 
+            void EnableNodeCache(IBufferManager *buffer_manager);
+            void GetNodeCacheStatistics(NodeCacheStatistics *out) const;
+
             s32 GetEntryCount() const { return m_entry_count; }
             IAllocator *GetAllocator() const { return m_node_l1.GetAllocator(); }
 
@@ -262,6 +289,11 @@ namespace ams::fssystem {
             s64 GetEntrySetIndex(s32 node_index, s32 offset_index) const {
                 return (m_offset_count - m_node_l1->count) + (m_offset_count * node_index) + offset_index;
             }
+
+            Result ReadNodeL2(char *buffer, s32 node_index) const;
+            Result ReadEntrySet(char *buffer, s32 entry_set_index) const;
+            Result ReadNodeWithCache(char *buffer, fs::SubStorage &storage, s64 offset, s64 key) const;
+            void ClearNodeCache();
     };
 
     class BucketTree::Visitor {
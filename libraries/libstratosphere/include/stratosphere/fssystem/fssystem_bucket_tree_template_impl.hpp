@@ -50,8 +50,7 @@ namespace ams::fssystem {
         /* Read the node. */
         if (m_node_size <= pool.GetSize()) {
             buffer = pool.GetBuffer();
-            const auto ofs = param.entry_set.index * static_cast<s64>(m_node_size);
-            R_TRY(m_entry_storage.Read(ofs, buffer, m_node_size));
+            R_TRY(this->ReadEntrySet(buffer, param.entry_set.index));
         }
 
         /* Calculate extents. */
@@ -115,6 +115,9 @@ namespace ams::fssystem {
                 return m_table.Initialize(allocator, node_storage, entry_storage, NodeSize, sizeof(Entry), entry_count);
             }
 
+            void EnableNodeCache(IBufferManager *buffer_manager) { m_table.EnableNodeCache(buffer_manager); }
+            void GetNodeCacheStatistics(BucketTree::NodeCacheStatistics *out) const { m_table.GetNodeCacheStatistics(out); }
+
             void SetStorage(s32 idx, fs::SubStorage storage) {
                 AMS_ASSERT(0 <= idx && idx < StorageCount);
                 m_data_storage[idx] = storage;
@@ -34,6 +34,7 @@ namespace ams::htcs {
     s32 Fcntl(s32 desc, s32 command, s32 value);
 
     s32 Select(s32 count, FdSet *read, FdSet *write, FdSet *exception, TimeVal *timeout);
+    s32 Poll(PollFd *fds, s32 count, s32 timeout);
 
     ssize_t Recv(s32 desc, void *buffer, size_t buffer_size, s32 flags);
     ssize_t Send(s32 desc, const void *buffer, size_t buffer_size, s32 flags);
@@ -43,4 +44,18 @@ namespace ams::htcs {
     void FdSetClr(s32 fd, FdSet *set);
     bool FdSetIsSet(s32 fd, const FdSet *set);
 
+    class PollSet {
+        private:
+            PollFd m_fds[SocketCountMax];
+            s32 m_count;
+        public:
+            constexpr PollSet() : m_fds(), m_count(0) { /* ... */ }
+
+            s32 Add(s32 desc, s16 events);
+            s32 Modify(s32 desc, s16 events);
+            s32 Remove(s32 desc);
+
+            s32 Wait(PollFd *out, s32 max_count, s32 timeout);
+    };
+
 }
@@ -52,6 +52,12 @@ namespace ams::htcs {
         int fds[FdSetSize];
     };
 
+    struct PollFd {
+        s32 fd;
+        s16 events;
+        s16 revents;
+    };
+
     enum SocketError {
         HTCS_ENONE         =  0,
         HTCS_EACCES        =  2,
@@ -104,6 +110,12 @@ namespace ams::htcs {
         HTCS_O_NONBLOCK = 4,
     };
 
+    enum PollEvent {
+        HTCS_POLLIN  = (1 << 0),
+        HTCS_POLLPRI = (1 << 1),
+        HTCS_POLLOUT = (1 << 2),
+    };
+
     enum AddressFamily {
         HTCS_AF_HTCS = 0,
     };
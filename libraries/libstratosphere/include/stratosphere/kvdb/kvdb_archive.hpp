@@ -14,6 +14,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #pragma once
+#include <stratosphere/fs/fs_file.hpp>
 #include <stratosphere/kvdb/kvdb_auto_buffer.hpp>
 
 namespace ams::kvdb {
@@ -47,6 +48,24 @@ namespace ams::kvdb {
             void WriteEntry(const void *key, size_t key_size, const void *value, size_t value_size);
     };
 
+    /* Writes an archive directly to a file, using the buffer only to combine small writes. */
+    class ArchiveFileWriter {
+        private:
+            fs::FileHandle m_file;
+            AutoBuffer &m_buffer;
+            s64 m_offset;
+            size_t m_buffered_size;
+        public:
+            ArchiveFileWriter(fs::FileHandle f, AutoBuffer &b) : m_file(f), m_buffer(b), m_offset(0), m_buffered_size(0) { /* ... */ }
+        private:
+            Result Write(const void *src, size_t size);
+            Result FlushBuffer();
+        public:
+            Result WriteHeader(size_t entry_count);
+            Result WriteEntry(const void *key, size_t key_size, const void *value, size_t value_size);
+            Result Flush();
+    };
+
     class ArchiveSizeHelper {
         private:
             size_t m_size;
@@ -90,12 +90,17 @@ namespace ams::kvdb {
 
             class Index {
                 private:
-                    size_t m_count;
+                    /* NOTE: While batching, entries past m_sorted_count are staged mutations which are merged in on the next access. */
+                    /* Staged removals and removed sorted entries have a null value. */
+                    mutable size_t m_count;
+                    mutable size_t m_sorted_count;
                     size_t m_capacity;
                     Entry *m_entries;
                     MemoryResource *m_memory_resource;
+                    bool m_is_batching;
+                    mutable bool m_has_removed_entries;
                 public:
-                    Index() : m_count(0), m_capacity(0), m_entries(nullptr), m_memory_resource(nullptr) { /* ... */ }
+                    Index() : m_count(0), m_sorted_count(0), m_capacity(0), m_entries(nullptr), m_memory_resource(nullptr), m_is_batching(false), m_has_removed_entries(false) { /* ... */ }
 
                     ~Index() {
                         if (m_entries != nullptr) {
@@ -106,6 +111,7 @@ namespace ams::kvdb {
                     }
 
                     size_t GetCount() const {
+                        this->MergePending();
                         return m_count;
                     }
 
@@ -115,9 +121,26 @@ namespace ams::kvdb {
 
                     void ResetEntries() {
                         for (size_t i = 0; i < m_count; i++) {
-                            m_memory_resource->Deallocate(m_entries[i].GetValuePointer(), m_entries[i].GetValueSize());
+                            if (m_entries[i].GetValuePointer() != nullptr) {
+                                m_memory_resource->Deallocate(m_entries[i].GetValuePointer(), m_entries[i].GetValueSize());
+                            }
                         }
-                        m_count = 0;
+                        m_count               = 0;
+                        m_sorted_count        = 0;
+                        m_has_removed_entries = false;
+                    }
+
+                    void BeginBatch() {
+                        m_is_batching = true;
+                    }
+
+                    void EndBatch() {
+                        this->MergePending();
+                        m_is_batching = false;
+                    }
+
+                    bool IsBatching() const {
+                        return m_is_batching;
                     }
 
                     Result Initialize(size_t capacity, MemoryResource *mr) {
@@ -129,6 +152,11 @@ namespace ams::kvdb {
                     }
 
                     Result Set(const Key &key, const void *value, size_t value_size) {
+                        /* If we're batching, stage the mutation. */
+                        if (m_is_batching) {
+                            return this->SetBatched(key, value, value_size);
+                        }
+
                         /* Find entry for key. */
                         Entry *it = this->lower_bound(key);
                         if (it != this->end() && it->GetKey() == key) {
@@ -139,6 +167,7 @@ namespace ams::kvdb {
                             R_UNLESS(m_count < m_capacity, kvdb::ResultOutOfKeyResource());
                             std::memmove(it + 1, it, sizeof(*it) * (this->end() - it));
                             m_count++;
+                            m_sorted_count = m_count;
                         }
 
                         /* Allocate new value. */
@@ -152,13 +181,20 @@ namespace ams::kvdb {
                     }
 
                     Result AddUnsafe(const Key &key, void *value, size_t value_size) {
+                        AMS_ASSERT(m_sorted_count == m_count);
                         R_UNLESS(m_count < m_capacity, kvdb::ResultOutOfKeyResource());
 
                         m_entries[m_count++] = Entry(key, value, value_size);
+                        m_sorted_count = m_count;
                         return ResultSuccess();
                     }
 
                     Result Remove(const Key &key) {
+                        /* If we're batching, stage the mutation. */
+                        if (m_is_batching) {
+                            return this->RemoveBatched(key);
+                        }
+
                         /* Find entry for key. */
                         Entry *it = this->find(key);
                         R_UNLESS(it != this->end(), kvdb::ResultKeyNotFound());
@@ -167,6 +203,7 @@ namespace ams::kvdb {
                         m_memory_resource->Deallocate(it->GetValuePointer(), it->GetValueSize());
                         std::memmove(it, it + 1, sizeof(*it) * (this->end() - (it + 1)));
                         m_count--;
+                        m_sorted_count = m_count;
                         return ResultSuccess();
                     }
 
@@ -210,20 +247,125 @@ namespace ams::kvdb {
                         return this->Find(key);
                     }
                 private:
+                    Entry *FindSorted(const Key &key) {
+                        /* Find an entry for the key among the sorted entries, without merging staged mutations. */
+                        Entry *end = m_entries + m_sorted_count;
+                        Entry *it  = std::lower_bound(m_entries, end, key);
+                        if (it != end && it->GetKey() == key) {
+                            return it;
+                        }
+                        return nullptr;
+                    }
+
+                    Result SetBatched(const Key &key, const void *value, size_t value_size) {
+                        /* Allocate the new value. */
+                        void *new_value = m_memory_resource->Allocate(value_size);
+                        R_UNLESS(new_value != nullptr, kvdb::ResultAllocationFailed());
+                        std::memcpy(new_value, value, value_size);
+
+                        /* If the key is already sorted, we can replace it in place. */
+                        Entry *it = this->FindSorted(key);
+
+                        /* Otherwise, we need a slot to stage it. Merging may free some up, and may sort the key. */
+                        if (it == nullptr && m_count == m_capacity) {
+                            this->MergePending();
+                            it = this->FindSorted(key);
+                        }
+
+                        if (it != nullptr) {
+                            if (it->GetValuePointer() != nullptr) {
+                                m_memory_resource->Deallocate(it->GetValuePointer(), it->GetValueSize());
+                            }
+                        } else {
+                            if (m_count == m_capacity) {
+                                m_memory_resource->Deallocate(new_value, value_size);
+                                return kvdb::ResultOutOfKeyResource();
+                            }
+                            it = m_entries + m_count++;
+                        }
+
+                        *it = Entry(key, new_value, value_size);
+                        return ResultSuccess();
+                    }
+
+                    Result RemoveBatched(const Key &key) {
+                        bool found = false;
+
+                        /* Remove the sorted entry for the key, if there is one. */
+                        if (Entry *it = this->FindSorted(key); it != nullptr && it->GetValuePointer() != nullptr) {
+                            m_memory_resource->Deallocate(it->GetValuePointer(), it->GetValueSize());
+                            *it = Entry(key, nullptr, 0);
+                            m_has_removed_entries = true;
+                            found = true;
+                        } else {
+                            /* The key may have been staged earlier in this batch, possibly more than once. */
+                            for (Entry *staged = m_entries + m_sorted_count; staged != m_entries + m_count; ++staged) {
+                                if (staged->GetKey() == key && staged->GetValuePointer() != nullptr) {
+                                    m_memory_resource->Deallocate(staged->GetValuePointer(), staged->GetValueSize());
+                                    *staged = Entry(key, nullptr, 0);
+                                    found = true;
+                                }
+                            }
+                        }
+
+                        R_UNLESS(found, kvdb::ResultKeyNotFound());
+                        return ResultSuccess();
+                    }
+
+                    void MergePending() const {
+                        /* If nothing was staged and nothing was removed, the entries are already sorted. */
+                        if (m_sorted_count == m_count && !m_has_removed_entries) {
+                            return;
+                        }
+
+                        const auto KeyLess = [](const Entry &lhs, const Entry &rhs) -> bool { return lhs.GetKey() < rhs.GetKey(); };
+
+                        /* Sort the staged entries, preserving their order for equal keys, and merge them with the sorted entries. */
+                        Entry *begin = m_entries;
+                        Entry *mid   = m_entries + m_sorted_count;
+                        Entry *end   = m_entries + m_count;
+                        std::stable_sort(mid, end, KeyLess);
+                        std::inplace_merge(begin, mid, end, KeyLess);
+
+                        /* Compact, keeping only the latest live entry for each key. */
+                        Entry *out = begin;
+                        for (Entry *it = begin; it != end; ++it) {
+                            const bool superseded = (it + 1 != end) && (it + 1)->GetKey() == it->GetKey();
+                            if (superseded) {
+                                if (it->GetValuePointer() != nullptr) {
+                                    m_memory_resource->Deallocate(it->GetValuePointer(), it->GetValueSize());
+                                }
+                                continue;
+                            }
+
+                            if (it->GetValuePointer() != nullptr) {
+                                *(out++) = *it;
+                            }
+                        }
+
+                        m_count               = out - begin;
+                        m_sorted_count        = m_count;
+                        m_has_removed_entries = false;
+                    }
+
                     Entry *GetBegin() {
+                        this->MergePending();
                         return m_entries;
                     }
 
                     const Entry *GetBegin() const {
+                        this->MergePending();
                         return m_entries;
                     }
 
                     Entry *GetEnd() {
-                        return this->GetBegin() + m_count;
+                        this->MergePending();
+                        return m_entries + m_count;
                     }
 
                     const Entry *GetEnd() const {
-                        return this->GetBegin() + m_count;
+                        this->MergePending();
+                        return m_entries + m_count;
                     }
 
                     Entry *GetLowerBound(const Key &key) {
@@ -254,6 +396,8 @@ namespace ams::kvdb {
             };
         private:
             using Path = kvdb::BoundedString<fs::EntryNameLengthMax>;
+
+            static constexpr size_t SaveBufferSize = 16_KB;
         private:
             Index m_index;
             Path m_path;
@@ -299,6 +443,19 @@ namespace ams::kvdb {
                 return m_index.GetCapacity();
             }
 
+            /* While batching, Set and Remove are staged, and merged with a single pass on the next access or EndBatch. */
+            void BeginBatch() {
+                m_index.BeginBatch();
+            }
+
+            void EndBatch() {
+                m_index.EndBatch();
+            }
+
+            bool IsBatching() const {
+                return m_index.IsBatching();
+            }
+
             Result Load() {
                 /* Reset any existing entries. */
                 m_index.ResetEntries();
@@ -341,22 +498,21 @@ namespace ams::kvdb {
             }
 
             Result Save(bool destructive = false) {
-                /* Create a buffer to hold the archive. */
-                AutoBuffer buffer;
-                R_TRY(buffer.Initialize(this->GetArchiveSize()));
+                if (destructive) {
+                    /* Delete and save to the real archive. */
+                    R_TRY(this->SaveArchiveToFile(m_path.Get()));
+                } else {
+                    /* Delete and save to a temporary archive. */
+                    R_TRY(this->SaveArchiveToFile(m_temp_path.Get()));
 
-                /* Write the archive to the buffer. */
-                {
-                    ArchiveWriter writer(buffer);
-                    writer.WriteHeader(this->GetCount());
-                    for (const auto &it : m_index) {
-                        const auto &key = it.GetKey();
-                        writer.WriteEntry(std::addressof(key), sizeof(Key), it.GetValuePointer(), it.GetValueSize());
-                    }
+                    /* Try to delete the saved archive, but allow deletion failure. */
+                    fs::DeleteFile(m_path.Get());
+
+                    /* Rename the path. */
+                    R_TRY(fs::RenameFile(m_temp_path.Get(), m_path.Get()));
                 }
 
-                /* Save the buffer to disk. */
-                return this->Commit(buffer, destructive);
+                return ResultSuccess();
             }
 
             Result Set(const Key &key, const void *value, size_t value_size) {
@@ -471,37 +627,33 @@ namespace ams::kvdb {
                 return m_index.find(key);
             }
         private:
-            Result SaveArchiveToFile(const char *path, const void *buf, size_t size) {
+            Result SaveArchiveToFile(const char *path) {
+                /* Determine the archive size. */
+                const size_t archive_size = this->GetArchiveSize();
+
+                /* Create a buffer to combine small writes. The archive itself is written straight from the index. */
+                AutoBuffer buffer;
+                R_TRY(buffer.Initialize(std::min(archive_size, SaveBufferSize)));
+
                 /* Try to delete the archive, but allow deletion failure. */
                 fs::DeleteFile(path);
 
                 /* Create new archive. */
-                R_TRY(fs::CreateFile(path, size));
+                R_TRY(fs::CreateFile(path, archive_size));
 
-                /* Write data to the archive. */
+                /* Write the archive. */
                 {
                     fs::FileHandle file;
                     R_TRY(fs::OpenFile(std::addressof(file), path, fs::OpenMode_Write));
                     ON_SCOPE_EXIT { fs::CloseFile(file); };
-                    R_TRY(fs::WriteFile(file, 0, buf, size, fs::WriteOption::Flush));
-                }
 
-                return ResultSuccess();
-            }
-
-            Result Commit(const AutoBuffer &buffer, bool destructive) {
-                if (destructive) {
-                    /* Delete and save to the real archive. */
-                    R_TRY(SaveArchiveToFile(m_path.Get(), buffer.Get(), buffer.GetSize()));
-                } else {
-                    /* Delete and save to a temporary archive. */
-                    R_TRY(SaveArchiveToFile(m_temp_path.Get(), buffer.Get(), buffer.GetSize()));
-
-                    /* Try to delete the saved archive, but allow deletion failure. */
-                    fs::DeleteFile(m_path.Get());
-
-                    /* Rename the path. */
-                    R_TRY(fs::RenameFile(m_temp_path.Get(), m_path.Get()));
+                    ArchiveFileWriter writer(file, buffer);
+                    R_TRY(writer.WriteHeader(this->GetCount()));
+                    for (const auto &it : m_index) {
+                        const auto &key = it.GetKey();
+                        R_TRY(writer.WriteEntry(std::addressof(key), sizeof(Key), it.GetValuePointer(), it.GetValueSize()));
+                    }
+                    R_TRY(writer.Flush());
                 }
 
                 return ResultSuccess();
@@ -26,4 +26,11 @@ namespace ams::lm {
         LogDestination_All           = 0xFFFF,
     };
 
+    struct LogBufferStatistics {
+        u64 push_count;
+        u64 drop_count;
+        u64 stall_count;
+    };
+    static_assert(util::is_pod<LogBufferStatistics>::value);
+
 }
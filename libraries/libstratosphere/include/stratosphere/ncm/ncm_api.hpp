@@ -26,6 +26,9 @@ namespace ams::ncm {
 
     void InitializeWithObject(sf::SharedPointer<IContentManager> manager_object);
 
+    /* Change tracking, only available when the content manager is hosted by this process. */
+    bool GetContentMetaDatabaseGeneration(u32 *out);
+
     /* Service API. */
     Result CreateContentStorage(StorageId storage_id);
     Result CreateContentMetaDatabase(StorageId storage_id);
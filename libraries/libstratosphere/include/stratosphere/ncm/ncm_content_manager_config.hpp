@@ -21,6 +21,7 @@ namespace ams::ncm {
     struct ContentManagerConfig {
         bool build_system_database;
         bool import_database_from_system_on_sd;
+        bool enable_content_id_index;
 
         bool HasAnyConfig() const {
             return this->ShouldBuildDatabase() || this->import_database_from_system_on_sd;
@@ -33,6 +34,10 @@ namespace ams::ncm {
         bool ShouldImportDatabaseFromSignedSystemPartitionOnSd() const {
             return this->import_database_from_system_on_sd;
         }
+
+        bool ShouldEnableContentIdIndex() const {
+            return this->enable_content_id_index;
+        }
     };
 
 }
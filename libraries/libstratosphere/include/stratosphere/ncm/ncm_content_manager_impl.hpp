@@ -105,6 +105,7 @@ namespace ams::ncm {
         private:
             os::SdkRecursiveMutex m_mutex;
             bool m_initialized;
+            bool m_content_id_index_enabled;
             ContentStorageRoot m_content_storage_roots[MaxContentStorageRoots];
             ContentMetaDatabaseRoot m_content_meta_database_roots[MaxContentMetaDatabaseRoots];
             u32 m_num_content_storage_entries;
@@ -112,7 +113,7 @@ namespace ams::ncm {
             RightsIdCache m_rights_id_cache;
             RegisteredHostContent m_registered_host_content;
         public:
-            ContentManagerImpl() : m_mutex(), m_initialized(false), m_content_storage_roots(), m_content_meta_database_roots(), m_num_content_storage_entries(0), m_num_content_meta_entries(0), m_rights_id_cache(), m_registered_host_content() {
+            ContentManagerImpl() : m_mutex(), m_initialized(false), m_content_id_index_enabled(false), m_content_storage_roots(), m_content_meta_database_roots(), m_num_content_storage_entries(0), m_num_content_meta_entries(0), m_rights_id_cache(), m_registered_host_content() {
                 /* ... */
             };
             ~ContentManagerImpl();
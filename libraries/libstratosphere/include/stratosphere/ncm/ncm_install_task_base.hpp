@@ -81,6 +81,12 @@ namespace ams::ncm {
     class InstallTaskBase {
         NON_COPYABLE(InstallTaskBase);
         NON_MOVEABLE(InstallTaskBase);
+        protected:
+            struct PlaceHolderHashState {
+                crypto::Sha256Context context;
+                size_t buffered_data_size;
+                u8 buffered_data[crypto::Sha256Generator::BlockSize];
+            };
         private:
             crypto::Sha256Generator m_sha256_generator;
             StorageId m_install_storage;
@@ -136,6 +142,12 @@ namespace ams::ncm {
             Result WritePlaceHolderBuffer(InstallContentInfo *content_info, const void *data, size_t data_size);
             void PrepareAgain();
 
+            /* Split stages of WritePlaceHolderBuffer, for callers which hash data before it is written. */
+            Result WritePlaceHolderBufferWithoutHash(InstallContentInfo *content_info, const void *data, size_t data_size);
+            void UpdatePlaceHolderHash(const void *data, size_t data_size);
+            void GetPlaceHolderHashState(PlaceHolderHashState *out) const;
+            void RestorePlaceHolderHashState(const PlaceHolderHashState &state);
+
             Result CountInstallContentMetaData(s32 *out_count);
             Result GetInstallContentMetaData(InstallContentMeta *out_content_meta, s32 index);
             Result DeleteInstallContentMetaData(const ContentMetaKey *keys, s32 num_keys);
@@ -19,6 +19,12 @@
 
 namespace ams::ncm {
 
+    struct PackageInstallThroughput {
+        InstallThroughput read;
+        InstallThroughput hash;
+        InstallThroughput write;
+    };
+
     class PackageInstallTaskBase : public InstallTaskBase {
         private:
             using PackagePath = kvdb::BoundedString<256>;
@@ -26,15 +32,24 @@ namespace ams::ncm {
             PackagePath m_package_root;
             void *m_buffer;
             size_t m_buffer_size;
+            PackageInstallThroughput m_stage_throughput;
+            os::SdkMutex m_stage_throughput_mutex;
         public:
-            PackageInstallTaskBase() : m_package_root() { /* ... */ }
+            PackageInstallTaskBase() : m_package_root(), m_stage_throughput(), m_stage_throughput_mutex() { /* ... */ }
 
             Result Initialize(const char *package_root_path, void *buffer, size_t buffer_size, StorageId storage_id, InstallTaskDataBase *data, u32 config);
+
+            PackageInstallThroughput GetStageThroughput();
         protected:
             const char *GetPackageRootPath() {
                 return m_package_root.Get();
             }
         private:
+            Result WritePlaceHolderFromFile(InstallContentInfo *content_info, fs::FileHandle file);
+            Result WritePlaceHolderFromFilePipelined(bool *out_pipelined, InstallContentInfo *content_info, fs::FileHandle file);
+
+            void UpdateStageThroughput(InstallThroughput PackageInstallThroughput::*stage, s64 size, TimeSpan elapsed_time);
+
             virtual Result OnWritePlaceHolder(const ContentMetaKey &key, InstallContentInfo *content_info) override;
             virtual Result InstallTicket(const fs::RightsId &rights_id, ContentMetaType meta_type) override;
 
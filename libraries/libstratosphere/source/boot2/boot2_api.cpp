@@ -156,8 +156,13 @@ namespace ams::boot2 {
         }
 
         void LaunchList(const ncm::SystemProgramId *launch_list, size_t num_entries) {
+            [[maybe_unused]] const auto start_tick = os::GetSystemTick();
             for (size_t i = 0; i < num_entries; i++) {
+                [[maybe_unused]] const auto launch_tick = os::GetSystemTick();
                 LaunchProgram(nullptr, ncm::ProgramLocation::Make(launch_list[i], ncm::StorageId::BuiltInSystem), 0);
+
+                /* Log the boot timeline, so that regressions in launch time are visible. */
+                AMS_LOG("[boot2] %016" PRIx64 ": launch started at %" PRId64 " us, took %" PRId64 " us\n", launch_list[i].value, (launch_tick - start_tick).ToTimeSpan().GetMicroSeconds(), (os::GetSystemTick() - launch_tick).ToTimeSpan().GetMicroSeconds());
             }
         }
 
@@ -72,6 +72,7 @@ namespace ams::erpt::srv {
     Result Attachment::SetFlags(AttachmentFlagSet flags) {
         if (((~m_record->m_info.flags) & flags).IsAnySet()) {
             m_record->m_info.flags |= flags;
+            Journal::MarkUpdated(m_record);
             return Journal::Commit();
         }
         return ResultSuccess();
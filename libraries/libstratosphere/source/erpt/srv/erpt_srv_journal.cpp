@@ -27,22 +27,44 @@ namespace ams::erpt::srv {
     }
 
     Result Journal::Commit() {
-        /* Open the stream. */
-        Stream stream;
-        R_TRY(stream.OpenStream(JournalFileName, StreamMode_Write, JournalStreamBufferSize));
+        /* If we can, append only the changes made since the last commit to the journal log. */
+        if (!JournalForLog::IsCompactionRequired()) {
+            if (R_SUCCEEDED(JournalForLog::CommitJournal())) {
+                Stream::CommitStream();
+                return ResultSuccess();
+            }
+        }
+
+        /* Until a new log is successfully started, all commits must rewrite the full journal. */
+        /* This also covers the case where we failed to append to the log, leaving a partial entry. */
+        JournalForLog::RequestCompaction();
+
+        /* Advance the log generation, so that the existing log will not be replayed against the new journal. */
+        JournalForMeta::AdvanceLogGeneration();
+
+        {
+            /* Open the stream. */
+            Stream stream;
+            R_TRY(stream.OpenStream(JournalFileName, StreamMode_Write, JournalStreamBufferSize));
+
+            /* Commit the reports. */
+            R_TRY(JournalForReports::CommitJournal(std::addressof(stream)));
 
-        /* Commit the reports. */
-        R_TRY(JournalForReports::CommitJournal(std::addressof(stream)));
+            /* Commit the meta. */
+            R_TRY(JournalForMeta::CommitJournal(std::addressof(stream)));
 
-        /* Commit the meta. */
-        R_TRY(JournalForMeta::CommitJournal(std::addressof(stream)));
+            /* Commit the attachments. */
+            R_TRY(JournalForAttachments::CommitJournal(std::addressof(stream)));
 
-        /* Commit the attachments. */
-        R_TRY(JournalForAttachments::CommitJournal(std::addressof(stream)));
+            /* Close the stream. */
+            stream.CloseStream();
+        }
 
-        /* Close and commit the stream. */
-        stream.CloseStream();
-        stream.CommitStream();
+        /* Start a new, empty log for the new journal. */
+        R_TRY(JournalForLog::ResetJournal());
+
+        /* Commit the streams. */
+        Stream::CommitStream();
 
         return ResultSuccess();
     }
@@ -97,6 +119,9 @@ namespace ams::erpt::srv {
         /* Restore the attachments. */
         R_TRY(JournalForAttachments::RestoreJournal(std::addressof(stream)));
 
+        /* Replay any changes which were appended to the log after the journal was written. */
+        JournalForLog::RestoreJournal();
+
         return ResultSuccess();
     }
 
@@ -116,4 +141,12 @@ namespace ams::erpt::srv {
         return JournalForAttachments::StoreRecord(record);
     }
 
+    void Journal::MarkUpdated(JournalRecord<ReportInfo> *record) {
+        return JournalForLog::RecordUpdated(record->m_info);
+    }
+
+    void Journal::MarkUpdated(JournalRecord<AttachmentInfo> *record) {
+        return JournalForLog::RecordUpdated(record->m_info);
+    }
+
 }
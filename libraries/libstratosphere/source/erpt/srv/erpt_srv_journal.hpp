@@ -31,10 +31,44 @@ namespace ams::erpt::srv {
         u32 transmitted_count[ReportType_Count];
         u32 untransmitted_count[ReportType_Count];
         util::Uuid journal_id;
-        u32 reserved[4];
+        u32 log_generation;
+        u32 reserved[3];
     };
     static_assert(sizeof(JournalMeta) == 0x34);
 
+    /* NOTE: Changes made between full journal commits are appended to a separate journal log. */
+    /* The log is only replayed when its generation matches the one in the full journal's meta. */
+    constexpr inline u32 JournalLogMagic   = util::FourCC<'E','J','L','G'>::Code;
+    constexpr inline u32 JournalLogVersion = 1;
+
+    constexpr inline u32 JournalLogPendingBufferSize   = 4_KB;
+    constexpr inline u32 JournalLogCompactionThreshold = 32_KB;
+
+    struct JournalLogHeader {
+        u32 magic;
+        u32 version;
+        u32 generation;
+        u32 reserved;
+    };
+    static_assert(sizeof(JournalLogHeader) == 0x10);
+
+    enum JournalLogEntryType : u16 {
+        JournalLogEntryType_ReportStored      = 1,
+        JournalLogEntryType_ReportUpdated     = 2,
+        JournalLogEntryType_ReportDeleted     = 3,
+        JournalLogEntryType_AttachmentStored  = 4,
+        JournalLogEntryType_AttachmentUpdated = 5,
+        JournalLogEntryType_AttachmentDeleted = 6,
+        JournalLogEntryType_Meta              = 7,
+    };
+
+    struct JournalLogEntryHeader {
+        u16 type;
+        u16 reserved;
+        u32 size;
+    };
+    static_assert(sizeof(JournalLogEntryHeader) == 0x8);
+
     class JournalForMeta {
         private:
             static JournalMeta s_journal_meta;
@@ -46,6 +80,9 @@ namespace ams::erpt::srv {
             static u32 GetUntransmittedCount(ReportType type);
             static void IncrementCount(bool transmitted, ReportType type);
             static util::Uuid GetJournalId();
+            static u32 GetLogGeneration();
+            static void AdvanceLogGeneration();
+            static void RestoreMeta(const JournalMeta &meta);
     };
 
     class JournalForReports {
@@ -70,6 +107,10 @@ namespace ams::erpt::srv {
 
             static JournalRecord<ReportInfo> *RetrieveRecord(ReportId report_id);
             static Result StoreRecord(JournalRecord<ReportInfo> *record);
+
+            static Result ReplayStoredRecord(const ReportInfo &info);
+            static void   ReplayUpdatedRecord(const ReportInfo &info);
+            static void   ReplayDeletedRecord(ReportId report_id);
     };
 
     class JournalForAttachments {
@@ -91,6 +132,38 @@ namespace ams::erpt::srv {
             static Result StoreRecord(JournalRecord<AttachmentInfo> *record);
 
             static Result SubmitAttachment(AttachmentId *out, char *name, const u8 *data, u32 data_size);
+
+            static Result ReplayStoredRecord(const AttachmentInfo &info);
+            static void   ReplayUpdatedRecord(const AttachmentInfo &info);
+            static void   ReplayDeletedRecord(AttachmentId attachment_id);
+            static bool   CleanupOrphanedAttachments();
+    };
+
+    class JournalForLog {
+        private:
+            static u8 s_pending_buffer[JournalLogPendingBufferSize];
+            static u32 s_pending_size;
+            static u32 s_log_size;
+            static bool s_meta_dirty;
+            static bool s_compaction_required;
+        private:
+            static void RecordEntry(JournalLogEntryType type, const void *data, u32 size);
+            static Result ReplayEntry(const JournalLogEntryHeader &header, Stream *stream);
+            static void ClearPending();
+        public:
+            static void   RecordStored(const ReportInfo &info);
+            static void   RecordUpdated(const ReportInfo &info);
+            static void   RecordDeleted(ReportId report_id);
+            static void   RecordStored(const AttachmentInfo &info);
+            static void   RecordUpdated(const AttachmentInfo &info);
+            static void   RecordDeleted(AttachmentId attachment_id);
+            static void   RecordMetaUpdated();
+
+            static void   RequestCompaction();
+            static bool   IsCompactionRequired();
+            static Result CommitJournal();
+            static Result ResetJournal();
+            static void   RestoreJournal();
     };
 
     class Journal {
@@ -114,6 +187,9 @@ namespace ams::erpt::srv {
 
             static Result Store(JournalRecord<ReportInfo> *record);
             static Result Store(JournalRecord<AttachmentInfo> *record);
+
+            static void MarkUpdated(JournalRecord<ReportInfo> *record);
+            static void MarkUpdated(JournalRecord<AttachmentInfo> *record);
     };
 
 }
@@ -43,6 +43,8 @@ namespace ams::erpt::srv {
         s_attachment_count = 0;
         s_used_storage     = 0;
 
+        /* The attachments can only be cleared by a full commit. */
+        JournalForLog::RequestCompaction();
     }
 
     Result JournalForAttachments::CommitJournal(Stream *stream) {
@@ -64,6 +66,9 @@ namespace ams::erpt::srv {
                 --s_attachment_count;
                 s_used_storage -= static_cast<u32>(record->m_info.attachment_size);
 
+                /* Record the deletion in the journal log. */
+                JournalForLog::RecordDeleted(record->m_info.attachment_id);
+
                 /* Delete the object, if we should. */
                 if (record->RemoveReference()) {
                     Stream::DeleteStream(Attachment::FileName(record->m_info.attachment_id).name);
@@ -153,6 +158,8 @@ namespace ams::erpt::srv {
 
                 record->m_info.owner_report_id = report_id;
                 record->m_info.flags.Set<AttachmentFlag::HasOwner>();
+
+                JournalForLog::RecordUpdated(record->m_info);
                 return ResultSuccess();
             }
         }
@@ -173,6 +180,9 @@ namespace ams::erpt::srv {
         s_attachment_count++;
         s_used_storage += static_cast<u32>(record->m_info.attachment_size);
 
+        /* Record the new attachment in the journal log. */
+        JournalForLog::RecordStored(record->m_info);
+
         return ResultSuccess();
     }
 
@@ -220,4 +230,75 @@ namespace ams::erpt::srv {
         return ResultSuccess();
     }
 
+    Result JournalForAttachments::ReplayStoredRecord(const AttachmentInfo &info) {
+        auto *record = new JournalRecord<AttachmentInfo>(info);
+        R_UNLESS(record != nullptr, erpt::ResultOutOfMemory());
+
+        auto record_guard = SCOPE_GUARD { delete record; };
+
+        /* If the attachment's file no longer exists, there is nothing to restore. */
+        R_SUCCEED_IF(R_FAILED(Stream::GetStreamSize(std::addressof(record->m_info.attachment_size), Attachment::FileName(record->m_info.attachment_id).name)));
+
+        /* NOTE: Ownership is checked once the entire log has been replayed, as attachments are stored before being owned. */
+        record_guard.Cancel();
+        StoreRecord(record);
+        return ResultSuccess();
+    }
+
+    void JournalForAttachments::ReplayUpdatedRecord(const AttachmentInfo &info) {
+        /* NOTE: Updates may be logged for records which were already deleted, so missing records are ignored. */
+        if (auto *record = RetrieveRecord(info.attachment_id); record != nullptr) {
+            record->m_info.owner_report_id = info.owner_report_id;
+            record->m_info.flags           = info.flags;
+        }
+    }
+
+    void JournalForAttachments::ReplayDeletedRecord(AttachmentId attachment_id) {
+        auto *record = RetrieveRecord(attachment_id);
+        if (record == nullptr) {
+            return;
+        }
+
+        /* Erase from the list. */
+        s_attachment_list.erase(s_attachment_list.iterator_to(*record));
+
+        /* Update storage tracking counts. */
+        --s_attachment_count;
+        s_used_storage -= static_cast<u32>(record->m_info.attachment_size);
+
+        /* NOTE: The attachment's file was deleted when the deletion was logged. */
+        if (record->RemoveReference()) {
+            delete record;
+        }
+    }
+
+    bool JournalForAttachments::CleanupOrphanedAttachments() {
+        bool cleaned_up = false;
+
+        for (auto it = s_attachment_list.begin(); it != s_attachment_list.end(); /* ... */) {
+            auto *record = std::addressof(*it);
+            if (record->m_info.flags.Test<AttachmentFlag::HasOwner>() && JournalForReports::RetrieveRecord(record->m_info.owner_report_id) != nullptr) {
+                it++;
+                continue;
+            }
+
+            /* Erase from the list. */
+            it = s_attachment_list.erase(s_attachment_list.iterator_to(*record));
+
+            /* Update storage tracking counts. */
+            --s_attachment_count;
+            s_used_storage -= static_cast<u32>(record->m_info.attachment_size);
+
+            /* If the attachment has no owner (or we deleted the report), delete the file associated with it. */
+            if (record->RemoveReference()) {
+                Stream::DeleteStream(Attachment::FileName(record->m_info.attachment_id).name);
+                delete record;
+            }
+
+            cleaned_up = true;
+        }
+
+        return cleaned_up;
+    }
+
 }
@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) Atmosphère-NX
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stratosphere.hpp>
+#include "erpt_srv_journal.hpp"
+
+namespace ams::erpt::srv {
+
+    constinit u8 JournalForLog::s_pending_buffer[JournalLogPendingBufferSize];
+    constinit u32 JournalForLog::s_pending_size = 0;
+    constinit u32 JournalForLog::s_log_size = 0;
+    constinit bool JournalForLog::s_meta_dirty = false;
+    constinit bool JournalForLog::s_compaction_required = true;
+
+    namespace {
+
+        template<typename T>
+        Result ReadEntryData(T *out, const JournalLogEntryHeader &header, Stream *stream) {
+            R_UNLESS(header.size == sizeof(T), erpt::ResultCorruptJournal());
+
+            u32 read_size;
+            R_TRY(stream->ReadStream(std::addressof(read_size), reinterpret_cast<u8 *>(out), sizeof(T)));
+
+            R_UNLESS(read_size == sizeof(T), erpt::ResultCorruptJournal());
+            return ResultSuccess();
+        }
+
+    }
+
+    void JournalForLog::ClearPending() {
+        s_pending_size = 0;
+        s_meta_dirty   = false;
+    }
+
+    void JournalForLog::RecordEntry(JournalLogEntryType type, const void *data, u32 size) {
+        /* If we're going to write the full journal anyway, there's no need to record anything. */
+        if (s_compaction_required) {
+            return;
+        }
+
+        /* If we have too many pending changes, just write the full journal on next commit. */
+        const u32 entry_size = sizeof(JournalLogEntryHeader) + size;
+        if (s_pending_size + entry_size > sizeof(s_pending_buffer)) {
+            RequestCompaction();
+            return;
+        }
+
+        const JournalLogEntryHeader header = {
+            .type     = type,
+            .reserved = 0,
+            .size     = size,
+        };
+
+        std::memcpy(s_pending_buffer + s_pending_size, std::addressof(header), sizeof(header));
+        std::memcpy(s_pending_buffer + s_pending_size + sizeof(header), data, size);
+        s_pending_size += entry_size;
+    }
+
+    void JournalForLog::RecordStored(const ReportInfo &info) {
+        return RecordEntry(JournalLogEntryType_ReportStored, std::addressof(info), sizeof(info));
+    }
+
+    void JournalForLog::RecordUpdated(const ReportInfo &info) {
+        return RecordEntry(JournalLogEntryType_ReportUpdated, std::addressof(info), sizeof(info));
+    }
+
+    void JournalForLog::RecordDeleted(ReportId report_id) {
+        return RecordEntry(JournalLogEntryType_ReportDeleted, std::addressof(report_id), sizeof(report_id));
+    }
+
+    void JournalForLog::RecordStored(const AttachmentInfo &info) {
+        return RecordEntry(JournalLogEntryType_AttachmentStored, std::addressof(info), sizeof(info));
+    }
+
+    void JournalForLog::RecordUpdated(const AttachmentInfo &info) {
+        return RecordEntry(JournalLogEntryType_AttachmentUpdated, std::addressof(info), sizeof(info));
+    }
+
+    void JournalForLog::RecordDeleted(AttachmentId attachment_id) {
+        return RecordEntry(JournalLogEntryType_AttachmentDeleted, std::addressof(attachment_id), sizeof(attachment_id));
+    }
+
+    void JournalForLog::RecordMetaUpdated() {
+        /* NOTE: The meta is small and only its latest state matters, so it is written once per commit. */
+        s_meta_dirty = true;
+    }
+
+    void JournalForLog::RequestCompaction() {
+        s_compaction_required = true;
+        ClearPending();
+    }
+
+    bool JournalForLog::IsCompactionRequired() {
+        const u32 meta_entry_size = s_meta_dirty ? sizeof(JournalLogEntryHeader) + sizeof(JournalMeta) : 0;
+        return s_compaction_required || s_log_size + s_pending_size + meta_entry_size > JournalLogCompactionThreshold;
+    }
+
+    Result JournalForLog::CommitJournal() {
+        AMS_ASSERT(!s_compaction_required);
+
+        /* If nothing changed, we have nothing to write. */
+        R_SUCCEED_IF(s_pending_size == 0 && !s_meta_dirty);
+
+        /* Check that the log is the one we last wrote. */
+        s64 log_size;
+        R_TRY(Stream::GetStreamSize(std::addressof(log_size), JournalLogFileName));
+        R_UNLESS(log_size == s_log_size, erpt::ResultCorruptJournal());
+
+        /* Open the stream. */
+        Stream stream;
+        R_TRY(stream.OpenStream(JournalLogFileName, StreamMode_Append, JournalStreamBufferSize));
+
+        /* Write the pending entries. */
+        R_TRY(stream.WriteStream(s_pending_buffer, s_pending_size));
+        u32 written_size = s_pending_size;
+
+        /* Write the meta, if it changed. */
+        if (s_meta_dirty) {
+            const JournalLogEntryHeader header = {
+                .type     = JournalLogEntryType_Meta,
+                .reserved = 0,
+                .size     = sizeof(JournalMeta),
+            };
+
+            R_TRY(stream.WriteStream(reinterpret_cast<const u8 *>(std::addressof(header)), sizeof(header)));
+            R_TRY(JournalForMeta::CommitJournal(std::addressof(stream)));
+            written_size += sizeof(header) + sizeof(JournalMeta);
+        }
+
+        /* Close the stream. */
+        stream.CloseStream();
+
+        s_log_size += written_size;
+        ClearPending();
+
+        return ResultSuccess();
+    }
+
+    Result JournalForLog::ResetJournal() {
+        /* Open the stream, truncating any existing log. */
+        Stream stream;
+        R_TRY(stream.OpenStream(JournalLogFileName, StreamMode_Write, 0));
+
+        /* Write the header. */
+        const JournalLogHeader header = {
+            .magic      = JournalLogMagic,
+            .version    = JournalLogVersion,
+            .generation = JournalForMeta::GetLogGeneration(),
+            .reserved   = 0,
+        };
+        R_TRY(stream.WriteStream(reinterpret_cast<const u8 *>(std::addressof(header)), sizeof(header)));
+
+        /* Close the stream. */
+        stream.CloseStream();
+
+        s_log_size            = sizeof(header);
+        s_compaction_required = false;
+        ClearPending();
+
+        return ResultSuccess();
+    }
+
+    Result JournalForLog::ReplayEntry(const JournalLogEntryHeader &header, Stream *stream) {
+        switch (header.type) {
+            case JournalLogEntryType_ReportStored:
+                {
+                    ReportInfo info;
+                    R_TRY(ReadEntryData(std::addressof(info), header, stream));
+                    return JournalForReports::ReplayStoredRecord(info);
+                }
+            case JournalLogEntryType_ReportUpdated:
+                {
+                    ReportInfo info;
+                    R_TRY(ReadEntryData(std::addressof(info), header, stream));
+                    JournalForReports::ReplayUpdatedRecord(info);
+                    return ResultSuccess();
+                }
+            case JournalLogEntryType_ReportDeleted:
+                {
+                    ReportId report_id;
+                    R_TRY(ReadEntryData(std::addressof(report_id), header, stream));
+                    JournalForReports::ReplayDeletedRecord(report_id);
+                    return ResultSuccess();
+                }
+            case JournalLogEntryType_AttachmentStored:
+                {
+                    AttachmentInfo info;
+                    R_TRY(ReadEntryData(std::addressof(info), header, stream));
+                    return JournalForAttachments::ReplayStoredRecord(info);
+                }
+            case JournalLogEntryType_AttachmentUpdated:
+                {
+                    AttachmentInfo info;
+                    R_TRY(ReadEntryData(std::addressof(info), header, stream));
+                    JournalForAttachments::ReplayUpdatedRecord(info);
+                    return ResultSuccess();
+                }
+            case JournalLogEntryType_AttachmentDeleted:
+                {
+                    AttachmentId attachment_id;
+                    R_TRY(ReadEntryData(std::addressof(attachment_id), header, stream));
+                    JournalForAttachments::ReplayDeletedRecord(attachment_id);
+                    return ResultSuccess();
+                }
+            case JournalLogEntryType_Meta:
+                {
+                    JournalMeta meta;
+                    R_TRY(ReadEntryData(std::addressof(meta), header, stream));
+                    JournalForMeta::RestoreMeta(meta);
+                    return ResultSuccess();
+                }
+            default:
+                return erpt::ResultCorruptJournal();
+        }
+    }
+
+    void JournalForLog::RestoreJournal() {
+        /* Until the log is known to fully match the restored journal, all commits must rewrite the full journal. */
+        RequestCompaction();
+
+        /* Open the stream. If there's no log (e.g. the journal was written by an older version), there's nothing to replay. */
+        Stream stream;
+        if (R_FAILED(stream.OpenStream(JournalLogFileName, StreamMode_Read, JournalStreamBufferSize))) {
+            return;
+        }
+
+        /* Read and validate the header. */
+        u32 read_size;
+        JournalLogHeader header;
+        if (R_FAILED(stream.ReadStream(std::addressof(read_size), reinterpret_cast<u8 *>(std::addressof(header)), sizeof(header))) || read_size != sizeof(header)) {
+            return;
+        }
+
+        /* If the log was not written for the restored journal, it must not be replayed. */
+        if (header.magic != JournalLogMagic || header.version != JournalLogVersion || header.generation != JournalForMeta::GetLogGeneration()) {
+            return;
+        }
+
+        /* Replay entries until we reach the end of the log, or an entry which was not completely written. */
+        u32 log_size = sizeof(header);
+        bool complete = false;
+        while (true) {
+            JournalLogEntryHeader entry_header;
+            if (R_FAILED(stream.ReadStream(std::addressof(read_size), reinterpret_cast<u8 *>(std::addressof(entry_header)), sizeof(entry_header)))) {
+                break;
+            }
+
+            if (read_size == 0) {
+                complete = true;
+                break;
+            }
+
+            if (read_size != sizeof(entry_header) || R_FAILED(ReplayEntry(entry_header, std::addressof(stream)))) {
+                break;
+            }
+
+            log_size += sizeof(entry_header) + entry_header.size;
+        }
+
+        /* Attachments are only kept if their owner still exists once all changes are replayed. */
+        const bool cleaned_up = JournalForAttachments::CleanupOrphanedAttachments();
+
+        /* If the log fully describes the restored state, we can continue appending to it. */
+        /* Otherwise, the next commit will replace both the journal and the log. */
+        if (complete && !cleaned_up) {
+            s_log_size            = log_size;
+            s_compaction_required = false;
+        }
+
+        ClearPending();
+    }
+
+}
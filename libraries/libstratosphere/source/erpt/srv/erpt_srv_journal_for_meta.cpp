@@ -24,6 +24,9 @@ namespace ams::erpt::srv {
         std::memset(std::addressof(s_journal_meta), 0, sizeof(s_journal_meta));
         s_journal_meta.journal_id = util::GenerateUuid();
         s_journal_meta.version    = JournalVersion;
+
+        /* The new journal id can only be saved by a full commit. */
+        JournalForLog::RequestCompaction();
     }
 
     Result JournalForMeta::CommitJournal(Stream *stream) {
@@ -61,6 +64,8 @@ namespace ams::erpt::srv {
             } else {
                 s_journal_meta.untransmitted_count[type]++;
             }
+
+            JournalForLog::RecordMetaUpdated();
         }
     }
 
@@ -68,4 +73,20 @@ namespace ams::erpt::srv {
         return s_journal_meta.journal_id;
     }
 
+    u32 JournalForMeta::GetLogGeneration() {
+        return s_journal_meta.log_generation;
+    }
+
+    void JournalForMeta::AdvanceLogGeneration() {
+        s_journal_meta.log_generation++;
+    }
+
+    void JournalForMeta::RestoreMeta(const JournalMeta &meta) {
+        /* NOTE: The log generation is not changed by meta replayed from the log. */
+        const auto log_generation = s_journal_meta.log_generation;
+
+        s_journal_meta                = meta;
+        s_journal_meta.log_generation = log_generation;
+    }
+
 }
@@ -39,6 +39,9 @@ namespace ams::erpt::srv {
         s_used_storage = 0;
 
         std::memset(s_record_count_by_type, 0, sizeof(s_record_count_by_type));
+
+        /* The reports can only be cleared by a full commit. */
+        JournalForLog::RequestCompaction();
     }
 
     Result JournalForReports::CommitJournal(Stream *stream) {
@@ -58,6 +61,9 @@ namespace ams::erpt::srv {
         --s_record_count_by_type[record->m_info.type];
         s_used_storage -= static_cast<u32>(record->m_info.report_size);
 
+        /* Record the deletion in the journal log. */
+        JournalForLog::RecordDeleted(record->m_info.id);
+
         /* If we should increment count, do so. */
         if (increment_count) {
             JournalForMeta::IncrementCount(record->m_info.flags.Test<ReportFlag::Transmitted>(), record->m_info.type);
@@ -147,31 +153,64 @@ namespace ams::erpt::srv {
         for (u32 i = 0; i < count; i++) {
             R_TRY(stream->ReadStream(std::addressof(read_size), reinterpret_cast<u8 *>(std::addressof(info)), sizeof(info)));
 
-            R_UNLESS(read_size == sizeof(info),     erpt::ResultCorruptJournal());
-            R_UNLESS(ReportType_Start <= info.type, erpt::ResultCorruptJournal());
-            R_UNLESS(info.type < ReportType_End,    erpt::ResultCorruptJournal());
+            R_UNLESS(read_size == sizeof(info), erpt::ResultCorruptJournal());
+
+            R_TRY(ReplayStoredRecord(info));
+        }
 
-            auto *record = new JournalRecord<ReportInfo>(info);
-            R_UNLESS(record != nullptr, erpt::ResultOutOfMemory());
+        cleanup_guard.Cancel();
+        return ResultSuccess();
+    }
 
-            /* NOTE: Nintendo does not ensure that the newly allocated record does not leak in the failure case. */
-            /* We will ensure it is freed if we early error. */
-            auto record_guard = SCOPE_GUARD { delete record; };
+    Result JournalForReports::ReplayStoredRecord(const ReportInfo &info) {
+        R_UNLESS(ReportType_Start <= info.type, erpt::ResultCorruptJournal());
+        R_UNLESS(info.type < ReportType_End,    erpt::ResultCorruptJournal());
 
-            if (record->m_info.report_size == 0) {
-                R_UNLESS(R_SUCCEEDED(Stream::GetStreamSize(std::addressof(record->m_info.report_size), Report::FileName(record->m_info.id, false).name)), erpt::ResultCorruptJournal());
-            }
+        auto *record = new JournalRecord<ReportInfo>(info);
+        R_UNLESS(record != nullptr, erpt::ResultOutOfMemory());
 
-            record_guard.Cancel();
+        /* NOTE: Nintendo does not ensure that the newly allocated record does not leak in the failure case. */
+        /* We will ensure it is freed if we early error. */
+        auto record_guard = SCOPE_GUARD { delete record; };
 
-            /* NOTE: Nintendo does not check the result of storing the new record... */
-            StoreRecord(record);
+        if (record->m_info.report_size == 0) {
+            R_UNLESS(R_SUCCEEDED(Stream::GetStreamSize(std::addressof(record->m_info.report_size), Report::FileName(record->m_info.id, false).name)), erpt::ResultCorruptJournal());
         }
 
-        cleanup_guard.Cancel();
+        record_guard.Cancel();
+
+        /* NOTE: Nintendo does not check the result of storing the new record... */
+        StoreRecord(record);
         return ResultSuccess();
     }
 
+    void JournalForReports::ReplayUpdatedRecord(const ReportInfo &info) {
+        /* NOTE: Updates may be logged for records which were already deleted, so missing records are ignored. */
+        if (auto *record = RetrieveRecord(info.id); record != nullptr) {
+            record->m_info.flags = info.flags;
+        }
+    }
+
+    void JournalForReports::ReplayDeletedRecord(ReportId report_id) {
+        auto *record = RetrieveRecord(report_id);
+        if (record == nullptr) {
+            return;
+        }
+
+        /* Erase from the list. */
+        s_record_list.erase(s_record_list.iterator_to(*record));
+
+        /* Update storage tracking counts. */
+        --s_record_count;
+        --s_record_count_by_type[record->m_info.type];
+        s_used_storage -= static_cast<u32>(record->m_info.report_size);
+
+        /* NOTE: The report's file, its attachments, and the meta counts were all updated when the deletion was logged. */
+        if (record->RemoveReference()) {
+            delete record;
+        }
+    }
+
     JournalRecord<ReportInfo> *JournalForReports::RetrieveRecord(ReportId report_id) {
         for (auto it = s_record_list.begin(); it != s_record_list.end(); it++) {
             if (auto *record = std::addressof(*it); record->m_info.id == report_id) {
@@ -222,6 +261,9 @@ namespace ams::erpt::srv {
         s_record_count_by_type[record->m_info.type]++;
         s_used_storage += static_cast<u32>(record->m_info.report_size);
 
+        /* Record the new report in the journal log. */
+        JournalForLog::RecordStored(record->m_info);
+
         return ResultSuccess();
     }
 
@@ -78,6 +78,7 @@ namespace ams::erpt::srv {
     Result Report::SetFlags(ReportFlagSet flags) {
         if (((~m_record->m_info.flags) & flags).IsAnySet()) {
             m_record->m_info.flags |= flags;
+            Journal::MarkUpdated(m_record);
             return Journal::Commit();
         }
         return ResultSuccess();
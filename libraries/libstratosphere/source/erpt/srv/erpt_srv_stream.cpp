@@ -69,7 +69,7 @@ namespace ams::erpt::srv {
             }
         };
 
-        if (mode == StreamMode_Write) {
+        if (mode == StreamMode_Write || mode == StreamMode_Append) {
             s_fs_commit_mutex.Lock();
 
             while (true) {
@@ -81,7 +81,11 @@ namespace ams::erpt::srv {
                 } R_END_TRY_CATCH;
                 break;
             }
-            fs::SetFileSize(m_file_handle, 0);
+
+            /* Appending streams keep their existing contents. */
+            if (mode == StreamMode_Write) {
+                fs::SetFileSize(m_file_handle, 0);
+            }
         } else {
             R_UNLESS(mode == StreamMode_Read, erpt::ResultInvalidArgument());
 
@@ -89,6 +93,11 @@ namespace ams::erpt::srv {
         }
         auto file_guard = SCOPE_GUARD { fs::CloseFile(m_file_handle); };
 
+        s64 file_size = 0;
+        if (mode == StreamMode_Append) {
+            R_TRY(fs::GetFileSize(std::addressof(file_size), m_file_handle));
+        }
+
         std::strncpy(m_file_name, path, sizeof(m_file_name));
         m_file_name[sizeof(m_file_name) - 1] = '\x00';
 
@@ -103,7 +112,7 @@ namespace ams::erpt::srv {
         m_buffer_size     = m_buffer != nullptr ? buffer_size : 0;
         m_buffer_count    = 0;
         m_buffer_position = 0;
-        m_file_position   = 0;
+        m_file_position   = static_cast<u32>(file_size);
         m_stream_mode     = mode;
         m_initialized     = true;
 
@@ -159,7 +168,7 @@ namespace ams::erpt::srv {
     Result Stream::WriteStream(const u8 *src, u32 src_size) {
         R_UNLESS(s_can_access_fs,                   erpt::ResultInvalidPowerState());
         R_UNLESS(m_initialized,                     erpt::ResultNotInitialized());
-        R_UNLESS(m_stream_mode == StreamMode_Write, erpt::ResultNotInitialized());
+        R_UNLESS(this->IsWritable(),                erpt::ResultNotInitialized());
         R_UNLESS(src != nullptr || src_size == 0,   erpt::ResultInvalidArgument());
 
         if (m_buffer != nullptr) {
@@ -186,7 +195,7 @@ namespace ams::erpt::srv {
     void Stream::CloseStream() {
         if (m_initialized) {
             if (s_can_access_fs) {
-                if (m_stream_mode == StreamMode_Write) {
+                if (this->IsWritable()) {
                     this->Flush();
                     fs::FlushFile(m_file_handle);
                 }
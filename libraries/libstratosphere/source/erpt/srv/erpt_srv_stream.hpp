@@ -21,7 +21,8 @@ namespace ams::erpt::srv {
     enum StreamMode {
         StreamMode_Write   = 0,
         StreamMode_Read    = 1,
-        StreamMode_Invalid = 2,
+        StreamMode_Append  = 2,
+        StreamMode_Invalid = 3,
     };
 
     class Stream {
@@ -49,6 +50,8 @@ namespace ams::erpt::srv {
 
             Result GetStreamSize(s64 *out) const;
         private:
+            bool IsWritable() const { return m_stream_mode == StreamMode_Write || m_stream_mode == StreamMode_Append; }
+
             Result Flush();
         public:
             static void EnableFsAccess(bool en);
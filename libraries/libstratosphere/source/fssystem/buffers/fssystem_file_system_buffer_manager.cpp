@@ -240,35 +240,42 @@ namespace ams::fssystem {
     }
 
     const std::pair<uintptr_t, size_t> FileSystemBufferManager::AllocateBufferImpl(size_t size, const BufferAttribute &attr) {
-        std::scoped_lock lk(m_mutex);
-
         std::pair<uintptr_t, size_t> range = {};
         const auto order = m_buddy_heap.GetOrderFromBytes(size);
         AMS_ASSERT(order >= 0);
 
         while (true) {
-            if (auto address = m_buddy_heap.AllocateByOrder(order); address != 0) {
-                const auto allocated_size = m_buddy_heap.GetBytesFromOrder(order);
-                AMS_ASSERT(size <= allocated_size);
+            /* Try to allocate from the heap. */
+            {
+                std::scoped_lock lk(m_heap_mutex);
 
-                range.first  = reinterpret_cast<uintptr_t>(address);
-                range.second = allocated_size;
+                if (auto address = m_buddy_heap.AllocateByOrder(order); address != 0) {
+                    const auto allocated_size = m_buddy_heap.GetBytesFromOrder(order);
+                    AMS_ASSERT(size <= allocated_size);
 
-                const size_t free_size = m_buddy_heap.GetTotalFreeSize();
-                m_peak_free_size = std::min(m_peak_free_size, free_size);
+                    range.first  = reinterpret_cast<uintptr_t>(address);
+                    range.second = allocated_size;
 
-                const size_t total_allocatable_size = free_size + m_cache_handle_table.GetTotalCacheSize();
-                m_peak_total_allocatable_size = std::min(m_peak_total_allocatable_size, total_allocatable_size);
-                break;
+                    this->UpdateFreeSize();
+
+                    UpdatePeak(m_peak_free_size, m_free_size);
+
+                    const size_t total_allocatable_size = m_total_allocatable_size.fetch_sub(allocated_size) - allocated_size;
+                    UpdatePeak(m_peak_total_allocatable_size, total_allocatable_size);
+                    break;
+                }
             }
 
             /* Deallocate a buffer. */
+            /* NOTE: The table lock is taken without holding the heap lock, as the table lock must always be acquired first. */
+            std::scoped_lock lk(m_table_mutex);
+
             uintptr_t deallocate_address = 0;
             size_t    deallocate_size    = 0;
 
             ++m_retried_count;
             if (m_cache_handle_table.UnregisterOldest(std::addressof(deallocate_address), std::addressof(deallocate_size), attr, size)) {
-                this->DeallocateBuffer(deallocate_address, deallocate_size);
+                this->DeallocateEvictedBuffer(deallocate_address, deallocate_size);
             } else {
                 break;
             }
@@ -280,18 +287,34 @@ namespace ams::fssystem {
     void FileSystemBufferManager::DeallocateBufferImpl(uintptr_t address, size_t size) {
         AMS_ASSERT(util::IsPowerOfTwo(size));
 
-        std::scoped_lock lk(m_mutex);
+        std::scoped_lock lk(m_heap_mutex);
+
+        m_buddy_heap.Free(reinterpret_cast<void *>(address), m_buddy_heap.GetOrderFromBytes(size));
+        this->UpdateFreeSize();
+
+        m_total_allocatable_size += size;
+    }
+
+    void FileSystemBufferManager::DeallocateEvictedBuffer(uintptr_t address, size_t size) {
+        /* NOTE: This must be called with the table lock held, after the buffer's cache has been unregistered. */
+        /* Moving a buffer from the cache table to the heap doesn't change the total allocatable size, */
+        /* so the counter is left alone and a concurrent sample can never observe the eviction half-done. */
+        AMS_ASSERT(util::IsPowerOfTwo(size));
+
+        std::scoped_lock lk(m_heap_mutex);
 
         m_buddy_heap.Free(reinterpret_cast<void *>(address), m_buddy_heap.GetOrderFromBytes(size));
+        this->UpdateFreeSize();
     }
 
     FileSystemBufferManager::CacheHandle FileSystemBufferManager::RegisterCacheImpl(uintptr_t address, size_t size, const BufferAttribute &attr) {
-        std::scoped_lock lk(m_mutex);
+        std::scoped_lock lk(m_table_mutex);
 
         CacheHandle handle = 0;
         while (true) {
             /* Try to register the handle. */
             if (m_cache_handle_table.Register(std::addressof(handle), address, size, attr)) {
+                m_total_allocatable_size += size;
                 break;
             }
 
@@ -301,7 +324,7 @@ namespace ams::fssystem {
 
             ++m_retried_count;
             if (m_cache_handle_table.UnregisterOldest(std::addressof(deallocate_address), std::addressof(deallocate_size), attr)) {
-                this->DeallocateBuffer(deallocate_address, deallocate_size);
+                this->DeallocateEvictedBuffer(deallocate_address, deallocate_size);
             } else {
                 this->DeallocateBuffer(address, size);
                 handle = m_cache_handle_table.PublishCacheHandle();
@@ -313,17 +336,24 @@ namespace ams::fssystem {
     }
 
     const std::pair<uintptr_t, size_t> FileSystemBufferManager::AcquireCacheImpl(CacheHandle handle) {
-        std::scoped_lock lk(m_mutex);
-
         std::pair<uintptr_t, size_t> range = {};
-        if (m_cache_handle_table.Unregister(std::addressof(range.first), std::addressof(range.second), handle)) {
-            const size_t total_allocatable_size = m_buddy_heap.GetTotalFreeSize() + m_cache_handle_table.GetTotalCacheSize();
-            m_peak_total_allocatable_size = std::min(m_peak_total_allocatable_size, total_allocatable_size);
-        } else {
-            range.first  = 0;
-            range.second = 0;
+
+        /* Acquire the cache. */
+        {
+            std::scoped_lock lk(m_table_mutex);
+
+            if (!m_cache_handle_table.Unregister(std::addressof(range.first), std::addressof(range.second), handle)) {
+                range.first  = 0;
+                range.second = 0;
+                return range;
+            }
         }
 
+        /* The cache's buffer now belongs to the caller, so it's no longer allocatable. */
+        /* NOTE: This is tracked by a counter, so that a cache hit doesn't need the heap lock to update our peak. */
+        const size_t total_allocatable_size = m_total_allocatable_size.fetch_sub(range.second) - range.second;
+        UpdatePeak(m_peak_total_allocatable_size, total_allocatable_size);
+
         return range;
     }
 
@@ -332,9 +362,7 @@ namespace ams::fssystem {
     }
 
     size_t FileSystemBufferManager::GetFreeSizeImpl() const {
-        std::scoped_lock lk(m_mutex);
-
-        return m_buddy_heap.GetTotalFreeSize();
+        return m_free_size;
     }
 
     size_t FileSystemBufferManager::GetTotalAllocatableSizeImpl() const {
@@ -358,4 +386,17 @@ namespace ams::fssystem {
         m_retried_count  = 0;
     }
 
+    void FileSystemBufferManager::UpdateFreeSize() {
+        /* NOTE: This must be called with the heap lock held. */
+        m_free_size = m_buddy_heap.GetTotalFreeSize();
+    }
+
+    void FileSystemBufferManager::UpdatePeak(std::atomic<size_t> &peak, size_t size) {
+        /* Peaks track the minimum observed size, and may be updated concurrently. */
+        size_t cur = peak.load();
+        while (size < cur && !peak.compare_exchange_weak(cur, size)) {
+            /* ... */
+        }
+    }
+
 }
@@ -206,6 +206,16 @@ namespace ams::fssystem {
 
     void BucketTree::Finalize() {
         if (this->IsInitialized()) {
+            /* Release our node cache. */
+            if (m_node_cache_entries != nullptr) {
+                this->ClearNodeCache();
+                this->GetAllocator()->Deallocate(m_node_cache_entries, sizeof(NodeCacheEntry) * m_node_cache_entry_count);
+
+                m_node_cache_entries     = nullptr;
+                m_node_cache_entry_count = 0;
+            }
+            m_buffer_manager = nullptr;
+
             m_node_storage    = fs::SubStorage();
             m_entry_storage   = fs::SubStorage();
             m_node_l1.Free(m_node_size);
@@ -232,6 +242,9 @@ namespace ams::fssystem {
     }
 
     Result BucketTree::InvalidateCache() {
+        /* Invalidate our cached nodes. */
+        this->ClearNodeCache();
+
         /* Invalidate the node storage cache. */
         {
             s64 storage_size;
@@ -276,6 +289,128 @@ namespace ams::fssystem {
         return ResultSuccess();
     }
 
+    void BucketTree::EnableNodeCache(IBufferManager *buffer_manager) {
+        AMS_ASSERT(this->IsInitialized());
+        AMS_ASSERT(m_node_cache_entries == nullptr);
+
+        /* Without a buffer manager, or for an empty tree, there's nothing to cache. */
+        if (buffer_manager == nullptr || this->IsEmpty()) {
+            return;
+        }
+
+        /* Determine how many nodes we can cache. */
+        const s32 node_count    = GetNodeL2Count(m_node_size, m_entry_size, m_entry_count) + m_entry_set_count;
+        const size_t cache_size = buffer_manager->GetTotalSize() / NodeCacheBufferManagerShareDivisor;
+        const s32 cache_count   = static_cast<s32>(std::min<s64>(std::min(node_count, NodeCacheEntryCountMax), cache_size / m_node_size));
+        if (cache_count <= 0) {
+            return;
+        }
+
+        /* Allocate the cache entries. If we can't, we just don't cache. */
+        auto *entries = static_cast<NodeCacheEntry *>(this->GetAllocator()->Allocate(sizeof(NodeCacheEntry) * cache_count, alignof(NodeCacheEntry)));
+        if (entries == nullptr) {
+            return;
+        }
+
+        for (s32 i = 0; i < cache_count; ++i) {
+            entries[i].key    = InvalidNodeCacheKey;
+            entries[i].handle = 0;
+        }
+
+        m_buffer_manager         = buffer_manager;
+        m_node_cache_entries     = entries;
+        m_node_cache_entry_count = cache_count;
+    }
+
+    void BucketTree::GetNodeCacheStatistics(NodeCacheStatistics *out) const {
+        AMS_ASSERT(out != nullptr);
+
+        out->hit_count  = m_node_cache_hit_count;
+        out->miss_count = m_node_cache_miss_count;
+    }
+
+    Result BucketTree::ReadNodeL2(char *buffer, s32 node_index) const {
+        /* NOTE: L2 nodes and entry sets share the cache; L2 nodes use even keys, and entry sets use odd ones. */
+        return this->ReadNodeWithCache(buffer, m_node_storage, (node_index + 1) * static_cast<s64>(m_node_size), static_cast<s64>(node_index) * 2);
+    }
+
+    Result BucketTree::ReadEntrySet(char *buffer, s32 entry_set_index) const {
+        return this->ReadNodeWithCache(buffer, m_entry_storage, entry_set_index * static_cast<s64>(m_node_size), static_cast<s64>(entry_set_index) * 2 + 1);
+    }
+
+    Result BucketTree::ReadNodeWithCache(char *buffer, fs::SubStorage &storage, s64 offset, s64 key) const {
+        /* If we have no cache, just read the node. */
+        if (m_node_cache_entries == nullptr) {
+            return storage.Read(offset, buffer, m_node_size);
+        }
+
+        /* NOTE: The cache is direct-mapped by key. */
+        NodeCacheEntry &entry = m_node_cache_entries[key % m_node_cache_entry_count];
+
+        /* Try to get the node from the cache. */
+        {
+            std::scoped_lock lk(m_node_cache_mutex);
+
+            if (entry.key == key) {
+                const auto range = m_buffer_manager->AcquireCache(entry.handle);
+                if (range.first != 0) {
+                    AMS_ASSERT(range.second >= m_node_size);
+                    std::memcpy(buffer, reinterpret_cast<const void *>(range.first), m_node_size);
+
+                    /* Give the node back to the buffer manager. */
+                    entry.handle = m_buffer_manager->RegisterCache(range.first, range.second, IBufferManager::BufferAttribute());
+
+                    ++m_node_cache_hit_count;
+                    return ResultSuccess();
+                }
+
+                /* The buffer manager evicted our node. */
+                entry.key = InvalidNodeCacheKey;
+            }
+        }
+
+        /* Read the node from storage. */
+        R_TRY(storage.Read(offset, buffer, m_node_size));
+        ++m_node_cache_miss_count;
+
+        /* Try to cache the node. If the buffer manager has no memory to spare, we just don't. */
+        const auto range = m_buffer_manager->AllocateBuffer(m_node_size);
+        if (range.first != 0) {
+            std::memcpy(reinterpret_cast<void *>(range.first), buffer, m_node_size);
+
+            std::scoped_lock lk(m_node_cache_mutex);
+
+            /* Evict whatever node was previously cached in the entry. */
+            if (entry.key != InvalidNodeCacheKey) {
+                const auto old_range = m_buffer_manager->AcquireCache(entry.handle);
+                if (old_range.first != 0) {
+                    m_buffer_manager->DeallocateBuffer(old_range.first, old_range.second);
+                }
+            }
+
+            entry.key    = key;
+            entry.handle = m_buffer_manager->RegisterCache(range.first, range.second, IBufferManager::BufferAttribute());
+        }
+
+        return ResultSuccess();
+    }
+
+    void BucketTree::ClearNodeCache() {
+        std::scoped_lock lk(m_node_cache_mutex);
+
+        for (s32 i = 0; i < m_node_cache_entry_count; ++i) {
+            auto &entry = m_node_cache_entries[i];
+            if (entry.key != InvalidNodeCacheKey) {
+                const auto range = m_buffer_manager->AcquireCache(entry.handle);
+                if (range.first != 0) {
+                    m_buffer_manager->DeallocateBuffer(range.first, range.second);
+                }
+
+                entry.key = InvalidNodeCacheKey;
+            }
+        }
+    }
+
     Result BucketTree::Visitor::Initialize(const BucketTree *tree) {
         AMS_ASSERT(tree != nullptr);
         AMS_ASSERT(m_tree == nullptr || m_tree == tree);
@@ -426,11 +561,9 @@ namespace ams::fssystem {
     Result BucketTree::Visitor::FindEntrySetWithBuffer(s32 *out_index, s64 virtual_address, s32 node_index, char *buffer) {
         /* Calculate node extents. */
         const auto node_size    = m_tree->m_node_size;
-        const auto node_offset  = (node_index + 1) * static_cast<s64>(node_size);
-        fs::SubStorage &storage = m_tree->m_node_storage;
 
         /* Read the node. */
-        R_TRY(storage.Read(node_offset, buffer, node_size));
+        R_TRY(m_tree->ReadNodeL2(buffer, node_index));
 
         /* Validate the header. */
         NodeHeader header;
@@ -484,11 +617,9 @@ namespace ams::fssystem {
         /* Calculate entry set extents. */
         const auto entry_size       = m_tree->m_entry_size;
         const auto entry_set_size   = m_tree->m_node_size;
-        const auto entry_set_offset = entry_set_index * static_cast<s64>(entry_set_size);
-        fs::SubStorage &storage     = m_tree->m_entry_storage;
 
         /* Read the entry set. */
-        R_TRY(storage.Read(entry_set_offset, buffer, entry_set_size));
+        R_TRY(m_tree->ReadEntrySet(buffer, entry_set_index));
 
         /* Validate the entry_set. */
         EntrySetHeader entry_set;
@@ -30,23 +30,29 @@ namespace ams::fssystem {
                     Key m_key;
                     Value m_value;
                     util::IntrusiveListNode m_mru_list_node;
+                    Node *m_hash_prev;
+                    Node *m_hash_next;
                 public:
-                    explicit Node(const Value &value) : m_value(value) { /* ... */ }
+                    explicit Node(const Value &value) : m_value(value), m_hash_prev(nullptr), m_hash_next(nullptr) { /* ... */ }
             };
         private:
             using MruList = typename util::IntrusiveListMemberTraits<&Node::m_mru_list_node>::ListType;
+        private:
+            static constexpr size_t HashBucketCount = 32;
+            static_assert(util::IsPowerOfTwo(HashBucketCount));
         private:
             MruList m_mru_list;
+            Node *m_hash_buckets[HashBucketCount];
         public:
-            constexpr LruListCache() : m_mru_list() { /* ... */ }
+            constexpr LruListCache() : m_mru_list(), m_hash_buckets() { /* ... */ }
 
             bool FindValueAndUpdateMru(Value *out, const Key &key) {
-                for (auto it = m_mru_list.begin(); it != m_mru_list.end(); ++it) {
-                    if (it->m_key == key) {
-                        *out = it->m_value;
+                for (Node *node = m_hash_buckets[GetHashBucketIndex(key)]; node != nullptr; node = node->m_hash_next) {
+                    if (node->m_key == key) {
+                        *out = node->m_value;
 
-                        m_mru_list.erase(it);
-                        m_mru_list.push_front(*it);
+                        m_mru_list.erase(m_mru_list.iterator_to(*node));
+                        m_mru_list.push_front(*node);
 
                         return true;
                     }
@@ -59,6 +65,7 @@ namespace ams::fssystem {
                 AMS_ABORT_UNLESS(!m_mru_list.empty());
                 Node *lru = std::addressof(*m_mru_list.rbegin());
                 m_mru_list.pop_back();
+                this->UnlinkHash(lru);
 
                 return std::unique_ptr<Node>(lru);
             }
@@ -66,13 +73,34 @@ namespace ams::fssystem {
             void PushMruNode(std::unique_ptr<Node> &&node, const Key &key) {
                 node->m_key = key;
                 m_mru_list.push_front(*node);
+                this->LinkHash(node.get());
                 node.release();
             }
 
+            template<typename F>
+            void InvalidateIf(F f, const Key &invalid_key) {
+                /* Move every node whose key matches to the lru end of the list, preserving the order of the others. */
+                auto it = m_mru_list.begin();
+                for (size_t remaining = m_mru_list.size(); remaining > 0; --remaining) {
+                    Node *node = std::addressof(*it);
+                    if (f(node->m_key)) {
+                        it = m_mru_list.erase(it);
+                        this->UnlinkHash(node);
+
+                        node->m_key = invalid_key;
+                        m_mru_list.push_back(*node);
+                        this->LinkHash(node);
+                    } else {
+                        ++it;
+                    }
+                }
+            }
+
             void DeleteAllNodes() {
                 while (!m_mru_list.empty()) {
                     Node *lru = std::addressof(*m_mru_list.rbegin());
                     m_mru_list.erase(m_mru_list.iterator_to(*lru));
+                    this->UnlinkHash(lru);
                     delete lru;
                 }
             }
@@ -84,6 +112,41 @@ namespace ams::fssystem {
             bool IsEmpty() const {
                 return m_mru_list.empty();
             }
+        private:
+            static size_t GetHashBucketIndex(const Key &key) {
+                /* NOTE: std::hash is the identity for integers, and keys are typically block-aligned offsets. */
+                /* Mix the hash with a golden-ratio multiply, and take the bucket index from its high bits. */
+                constexpr u64 GoldenRatio = UINT64_C(0x9E3779B97F4A7C15);
+                const u64 mixed = static_cast<u64>(std::hash<Key>{}(key)) * GoldenRatio;
+                return static_cast<size_t>(mixed >> (BITSIZEOF(u64) - util::CountTrailingZeros(HashBucketCount)));
+            }
+
+            void LinkHash(Node *node) {
+                Node *&head = m_hash_buckets[GetHashBucketIndex(node->m_key)];
+
+                node->m_hash_prev = nullptr;
+                node->m_hash_next = head;
+                if (head != nullptr) {
+                    head->m_hash_prev = node;
+                }
+                head = node;
+            }
+
+            void UnlinkHash(Node *node) {
+                if (node->m_hash_prev != nullptr) {
+                    node->m_hash_prev->m_hash_next = node->m_hash_next;
+                } else {
+                    AMS_ASSERT(m_hash_buckets[GetHashBucketIndex(node->m_key)] == node);
+                    m_hash_buckets[GetHashBucketIndex(node->m_key)] = node->m_hash_next;
+                }
+
+                if (node->m_hash_next != nullptr) {
+                    node->m_hash_next->m_hash_prev = node->m_hash_prev;
+                }
+
+                node->m_hash_prev = nullptr;
+                node->m_hash_next = nullptr;
+            }
     };
 
 }
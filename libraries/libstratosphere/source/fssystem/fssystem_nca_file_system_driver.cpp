@@ -754,6 +754,7 @@ namespace ams::fssystem {
 
             /* Initialize the aes ctr ex storage. */
             R_TRY(impl_storage->Initialize(m_allocator, m_reader->GetExternalDecryptionKey(), AesCtrStorage::KeySize, secure_value, base_storage_offset, data_storage, node_storage, entry_storage, entry_count, std::move(decryptor)));
+            impl_storage->EnableNodeCache(m_buffer_manager);
 
             /* Set the option's aes ctr ex storage. */
             option->SetAesCtrExStorageRaw(impl_storage.get());
@@ -773,6 +774,7 @@ namespace ams::fssystem {
 
             /* Initialize the software storage. */
             R_TRY(sw_storage->Initialize(m_allocator, m_reader->GetDecryptionKey(NcaHeader::DecryptionKey_AesCtr), AesCtrStorage::KeySize, secure_value, base_storage_offset, data_storage, node_storage, entry_storage, entry_count, std::move(sw_decryptor)));
+            sw_storage->EnableNodeCache(m_buffer_manager);
 
             /* Set the option's aes ctr ex storage. */
             option->SetAesCtrExStorageRaw(sw_storage.get());
@@ -789,6 +791,7 @@ namespace ams::fssystem {
 
                 /* Initialize the hardware storage. */
                 R_TRY(hw_storage->Initialize(m_allocator, m_reader->GetDecryptionKey(NcaHeader::DecryptionKey_AesCtrHw), AesCtrStorage::KeySize, secure_value, base_storage_offset, data_storage, node_storage, entry_storage, entry_count, std::move(hw_decryptor)));
+                hw_storage->EnableNodeCache(m_buffer_manager);
 
                 /* Create the selection storage. */
                 std::unique_ptr switch_storage = std::make_unique<SwitchStorage<bool (*)()>>(std::move(hw_storage), std::move(sw_storage), IsUsingHardwareAesCtrForSpeedEmulation);
@@ -892,6 +895,7 @@ namespace ams::fssystem {
 
         /* Initialize the storage holder. */
         R_TRY(storage->Initialize(m_allocator, fs::SubStorage(indirect_table_storage.get(), 0, node_size), fs::SubStorage(indirect_table_storage.get(), node_size, entry_size), header.entry_count));
+        storage->EnableNodeCache(m_buffer_manager);
 
         /* Set the storage holder's storages. */
         storage->SetStorage(0, original_storage.get(), 0, original_data_size);
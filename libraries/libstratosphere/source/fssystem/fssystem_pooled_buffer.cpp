@@ -88,6 +88,76 @@ namespace ams::fssystem {
 
         constinit AdditionalDeviceAddressEntry g_additional_device_address_entry;
 
+        /* Small buffers are allocated and freed on nearly every access, so recently freed ones are kept in per-core caches. */
+        /* This lets the common case avoid the heap lock entirely. Larger buffers always come from the heap. */
+        constexpr s32    CacheOrderMax           = HeapOrderTrim;
+        constexpr size_t CacheEntryCountPerOrder = 2;
+        constexpr s32    CacheCount              = 4;
+
+        class PerCoreBufferCache {
+            private:
+                std::atomic<char *> m_entries[CacheOrderMax + 1][CacheEntryCountPerOrder];
+            public:
+                constexpr PerCoreBufferCache() : m_entries() { /* ... */ }
+
+                char *Allocate(s32 order) {
+                    AMS_ASSERT(0 <= order && order <= CacheOrderMax);
+
+                    for (auto &entry : m_entries[order]) {
+                        if (char *buffer = entry.exchange(nullptr); buffer != nullptr) {
+                            return buffer;
+                        }
+                    }
+
+                    return nullptr;
+                }
+
+                bool Free(char *buffer, s32 order) {
+                    AMS_ASSERT(0 <= order && order <= CacheOrderMax);
+
+                    for (auto &entry : m_entries[order]) {
+                        char *expected = nullptr;
+                        if (entry.compare_exchange_strong(expected, buffer)) {
+                            return true;
+                        }
+                    }
+
+                    return false;
+                }
+
+                bool FlushToHeap() {
+                    /* NOTE: This must be called with the heap lock held. */
+                    bool flushed = false;
+                    for (s32 order = 0; order <= CacheOrderMax; ++order) {
+                        for (auto &entry : m_entries[order]) {
+                            if (char *buffer = entry.exchange(nullptr); buffer != nullptr) {
+                                g_heap.Free(buffer, order);
+                                flushed = true;
+                            }
+                        }
+                    }
+
+                    return flushed;
+                }
+        };
+
+        constinit PerCoreBufferCache g_buffer_caches[CacheCount];
+
+        PerCoreBufferCache &GetCurrentBufferCache() {
+            return g_buffer_caches[static_cast<u32>(os::GetCurrentProcessorNumber()) % CacheCount];
+        }
+
+        bool FlushBufferCaches() {
+            std::scoped_lock lk(g_heap_mutex);
+
+            bool flushed = false;
+            for (auto &cache : g_buffer_caches) {
+                flushed |= cache.FlushToHeap();
+            }
+
+            return flushed;
+        }
+
     }
 
     size_t PooledBuffer::GetAllocatableSizeMaxCore(bool large) {
@@ -105,6 +175,16 @@ namespace ams::fssystem {
 
         const size_t target_size = std::min(std::max(ideal_size, required_size), GetAllocatableSizeMaxCore(large));
 
+        /* Try to allocate from our cache. */
+        if (const auto order = g_heap.GetOrderFromBytes(target_size); order <= CacheOrderMax) {
+            if (char *buffer = GetCurrentBufferCache().Allocate(order); buffer != nullptr) {
+                m_buffer = buffer;
+                m_size   = g_heap.GetBytesFromOrder(order);
+                AMS_ASSERT(this->GetSize() >= required_size);
+                return;
+            }
+        }
+
         /* Loop until we allocate. */
         while (true) {
             /* Lock the heap and try to allocate. */
@@ -142,6 +222,11 @@ namespace ams::fssystem {
                 }
                 break;
             } else {
+                /* Return any cached buffers to the heap, and retry immediately if doing so might help. */
+                if (FlushBufferCaches()) {
+                    continue;
+                }
+
                 /* Sleep. */
                 os::SleepThread(RetryWait);
                 g_retry_count++;
@@ -170,6 +255,15 @@ namespace ams::fssystem {
 
             const size_t new_size = util::AlignUp(ideal_size, HeapBlockSize);
 
+            /* If we're freeing a small buffer entirely, try to keep it in our cache. */
+            if (new_size == 0 && util::IsPowerOfTwo(m_size)) {
+                if (const auto order = g_heap.GetOrderFromBytes(m_size); order <= CacheOrderMax && GetCurrentBufferCache().Free(m_buffer, order)) {
+                    m_buffer = nullptr;
+                    m_size   = 0;
+                    return;
+                }
+            }
+
             /* Repeatedly free the tail of our buffer until we're done. */
             {
                 std::scoped_lock lk(g_heap_mutex);
@@ -248,6 +342,9 @@ namespace ams::fssystem {
     }
 
     void ClearPooledBufferPeak() {
+        /* NOTE: Cached buffers are returned to the heap, so that the peak reflects only buffers in use. */
+        FlushBufferCaches();
+
         std::scoped_lock lk(g_heap_mutex);
         g_heap_free_size_peak     = g_heap.GetTotalFreeSize();
         g_retry_count             = 0;
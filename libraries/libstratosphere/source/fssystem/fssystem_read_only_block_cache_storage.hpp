@@ -98,22 +98,7 @@ namespace ams::fssystem {
 
                     std::scoped_lock lk(m_mutex);
 
-                    const size_t cache_block_count = m_block_cache.GetSize();
-                    BlockCache valid_cache;
-
-                    for (size_t count = 0; count < cache_block_count; ++count) {
-                        auto lru = m_block_cache.PopLruNode();
-                        if (offset <= lru->m_key && lru->m_key < offset + size) {
-                            m_block_cache.PushMruNode(std::move(lru), -1);
-                        } else {
-                            valid_cache.PushMruNode(std::move(lru), lru->m_key);
-                        }
-                    }
-
-                    while (!valid_cache.IsEmpty()) {
-                        auto lru = valid_cache.PopLruNode();
-                        m_block_cache.PushMruNode(std::move(lru), lru->m_key);
-                    }
+                    m_block_cache.InvalidateIf([&](s64 key) { return offset <= key && key < offset + size; }, -1);
                 }
 
                 /* Operate on the base storage. */
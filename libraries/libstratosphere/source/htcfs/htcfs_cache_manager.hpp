@@ -19,45 +19,129 @@
 namespace ams::htcfs {
 
     class CacheManager {
+        public:
+            static constexpr size_t BlockSize     = 16_KB;
+            static constexpr size_t MaxBlockCount = 8;
+            static constexpr size_t MaxFileCount  = 8;
+        private:
+            struct Block {
+                u8 *data;
+                s64 offset;
+                size_t data_size;
+                u32 last_used;
+                s32 handle;
+                bool is_end;
+                bool is_valid;
+            };
+
+            struct File {
+                s64 file_size;
+                s32 handle;
+                bool is_valid;
+            };
         private:
             os::SdkMutex m_mutex;
-            void *m_cache;
-            size_t m_cache_size;
-            s64 m_cached_file_size;
-            size_t m_cached_data_size;
-            s32 m_cached_handle;
-            bool m_has_cached_handle;
+            Block m_blocks[MaxBlockCount];
+            File m_files[MaxFileCount];
+            size_t m_block_count;
+            size_t m_next_file_index;
+            u32 m_use_counter;
         public:
-            CacheManager(void *cache, size_t cache_size) : m_mutex(), m_cache(cache), m_cache_size(cache_size), m_cached_file_size(), m_cached_data_size(), m_cached_handle(), m_has_cached_handle() { /* ... */ }
+            CacheManager(void *cache, size_t cache_size) : m_mutex(), m_blocks(), m_files(), m_block_count(std::min(cache_size / BlockSize, MaxBlockCount)), m_next_file_index(), m_use_counter() {
+                /* Carve our blocks out of the cache. */
+                for (size_t i = 0; i < m_block_count; ++i) {
+                    m_blocks[i].data = static_cast<u8 *>(cache) + i * BlockSize;
+                }
+            }
+        private:
+            Block *FindBlock(s32 handle, s64 offset) {
+                for (size_t i = 0; i < m_block_count; ++i) {
+                    if (Block &block = m_blocks[i]; block.is_valid && block.handle == handle && block.offset <= offset && offset < block.offset + static_cast<s64>(block.data_size)) {
+                        return std::addressof(block);
+                    }
+                }
+
+                return nullptr;
+            }
+
+            Block *AllocateBlock() {
+                /* Prefer an unused block, and otherwise evict the least recently used one. */
+                Block *lru_block = nullptr;
+                for (size_t i = 0; i < m_block_count; ++i) {
+                    if (!m_blocks[i].is_valid) {
+                        return std::addressof(m_blocks[i]);
+                    }
+
+                    if (lru_block == nullptr || static_cast<s32>(m_blocks[i].last_used - lru_block->last_used) < 0) {
+                        lru_block = std::addressof(m_blocks[i]);
+                    }
+                }
+
+                return lru_block;
+            }
+
+            void RecordBlockImpl(s32 handle, s64 offset, const void *data, size_t data_size, bool is_end) {
+                /* Get a block to record into. */
+                Block *block = this->AllocateBlock();
+                if (block == nullptr) {
+                    return;
+                }
+
+                /* Copy the data. */
+                AMS_ASSERT(data_size <= BlockSize);
+                std::memcpy(block->data, data, data_size);
+
+                /* Set the block's fields. */
+                block->offset    = offset;
+                block->data_size = data_size;
+                block->last_used = ++m_use_counter;
+                block->handle    = handle;
+                block->is_end    = is_end;
+                block->is_valid  = true;
+            }
         public:
             bool GetFileSize(s64 *out, s32 handle) {
                 /* Lock ourselves. */
                 std::scoped_lock lk(m_mutex);
 
-                /* Get the cached size, if we match. */
-                if (m_has_cached_handle && m_cached_handle == handle) {
-                    *out = m_cached_file_size;
-                    return true;
-                } else {
-                    return false;
+                /* Get the cached size, if we have one. */
+                for (const auto &file : m_files) {
+                    if (file.is_valid && file.handle == handle) {
+                        *out = file.file_size;
+                        return true;
+                    }
                 }
+
+                return false;
             }
 
             void Invalidate() {
                 /* Lock ourselves. */
                 std::scoped_lock lk(m_mutex);
 
-                /* Note that we have no handle. */
-                m_has_cached_handle = false;
+                /* Note that we have no handles. */
+                for (auto &file : m_files) {
+                    file.is_valid = false;
+                }
+                for (auto &block : m_blocks) {
+                    block.is_valid = false;
+                }
             }
 
             void Invalidate(s32 handle) {
                 /* Lock ourselves. */
                 std::scoped_lock lk(m_mutex);
 
-                if (m_has_cached_handle && m_cached_handle == handle) {
-                    /* Note that we have no handle. */
-                    m_has_cached_handle = false;
+                /* Invalidate anything we have cached for the handle. */
+                for (auto &file : m_files) {
+                    if (file.is_valid && file.handle == handle) {
+                        file.is_valid = false;
+                    }
+                }
+                for (auto &block : m_blocks) {
+                    if (block.is_valid && block.handle == handle) {
+                        block.is_valid = false;
+                    }
                 }
             }
 
@@ -65,46 +149,79 @@ namespace ams::htcfs {
                 /* Lock ourselves. */
                 std::scoped_lock lk(m_mutex);
 
-                /* Set our cached file size. */
-                m_cached_file_size = file_size;
-
-                /* Set our cached data size. */
-                m_cached_data_size = std::min(m_cache_size, data_size);
+                /* Set our cached file size, replacing the oldest file if we have no room. */
+                {
+                    File *file = nullptr;
+                    for (auto &cur : m_files) {
+                        if (!cur.is_valid || cur.handle == handle) {
+                            file = std::addressof(cur);
+                            break;
+                        }
+                    }
+                    if (file == nullptr) {
+                        file = std::addressof(m_files[m_next_file_index]);
+                        m_next_file_index = (m_next_file_index + 1) % MaxFileCount;
+                    }
+
+                    file->file_size = file_size;
+                    file->handle    = handle;
+                    file->is_valid  = true;
+                }
 
-                /* Copy the data. */
-                std::memcpy(m_cache, data, m_cached_data_size);
+                /* Record the data from the start of the file. */
+                for (size_t offset = 0; offset < data_size; offset += BlockSize) {
+                    const size_t cur_size = std::min(data_size - offset, BlockSize);
+                    this->RecordBlockImpl(handle, offset, static_cast<const u8 *>(data) + offset, cur_size, static_cast<s64>(offset + cur_size) >= file_size);
+                }
+            }
 
-                /* Set our cache handle. */
-                m_cached_handle = handle;
+            void RecordBlock(s32 handle, s64 offset, const void *data, size_t data_size, bool is_end) {
+                /* Lock ourselves. */
+                std::scoped_lock lk(m_mutex);
 
-                /* Note that we have cached data. */
-                m_has_cached_handle = true;
+                /* Record the block. */
+                if (data_size > 0) {
+                    this->RecordBlockImpl(handle, offset, data, data_size, is_end);
+                }
             }
 
             bool ReadFile(size_t *out, void *dst, s32 handle, size_t offset, size_t size) {
                 /* Lock ourselves. */
                 std::scoped_lock lk(m_mutex);
 
-                /* Check that we have a cached file. */
-                if (!m_has_cached_handle) {
-                    return false;
-                }
-
-                /* Check the file is our cached one. */
-                if (handle != m_cached_handle) {
+                /* Empty reads are left to the host, so that it can validate the handle. */
+                if (size == 0) {
                     return false;
                 }
 
-                /* Check that we can read data. */
-                if (offset + size > m_cached_data_size) {
-                    return false;
+                /* Copy data from our blocks, until we've read everything or reach the end of the file. */
+                /* NOTE: If we find a gap, the destination will be partially written, but the caller will read the data from the host anyway. */
+                size_t read_size = 0;
+                while (read_size < size) {
+                    /* Find the block containing the current offset. */
+                    const s64 cur_offset = static_cast<s64>(offset + read_size);
+                    Block *block = this->FindBlock(handle, cur_offset);
+                    if (block == nullptr) {
+                        return false;
+                    }
+
+                    /* Copy the cached data. */
+                    const size_t block_offset = static_cast<size_t>(cur_offset - block->offset);
+                    const size_t cur_size     = std::min(block->data_size - block_offset, size - read_size);
+                    std::memcpy(static_cast<u8 *>(dst) + read_size, block->data + block_offset, cur_size);
+                    read_size += cur_size;
+
+                    /* Note that we used the block. */
+                    block->last_used = ++m_use_counter;
+
+                    /* If the block is at the end of the file, we can't read any further. */
+                    if (block->is_end && block_offset + cur_size == block->data_size) {
+                        break;
+                    }
                 }
 
-                /* Copy the cached data. */
-                std::memcpy(dst, static_cast<const u8 *>(m_cache) + offset, size);
-
                 /* Set the output read size. */
-                *out = size;
+                *out = read_size;
 
                 return true;
             }
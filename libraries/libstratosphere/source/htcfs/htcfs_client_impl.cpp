@@ -28,7 +28,7 @@ namespace ams::htcfs {
         alignas(os::ThreadStackAlignment) constinit u8 g_monitor_thread_stack[os::MemoryPageSize];
 
         constexpr size_t FileDataCacheSize = 32_KB;
-        constinit u8 g_cache[FileDataCacheSize];
+        constinit u8 g_cache[CacheManager::BlockSize * CacheManager::MaxBlockCount];
 
         ALWAYS_INLINE Result ConvertNativeResult(s64 value) {
             return result::impl::MakeResult(value);
@@ -45,7 +45,12 @@ namespace ams::htcfs {
           m_rpc_channel(manager),
           m_data_channel(manager),
           m_connected(false),
-          m_event(os::EventClearMode_ManualClear)
+          m_event(os::EventClearMode_ManualClear),
+          m_pending_read_aheads(),
+          m_pending_read_ahead_head(0),
+          m_pending_read_ahead_count(0),
+          m_read_ahead_states(),
+          m_read_ahead_use_counter(0)
     {
         /* Start our thread. */
         this->Start();
@@ -86,6 +91,8 @@ namespace ams::htcfs {
             ON_SCOPE_EXIT {
                 m_rpc_channel.Close();
                 m_cache_manager.Invalidate();
+                this->ClearPendingReadAheads();
+                this->InvalidateReadAhead();
             };
 
             /* Set our channel config and buffers. */
@@ -373,6 +380,9 @@ namespace ams::htcfs {
     }
 
     Result ClientImpl::SendRequest(const Header &request, const void *arg1, size_t arg1_size, const void *arg2, size_t arg2_size) {
+        /* The host responds to requests in order, so we must receive any outstanding read-ahead responses before our own. */
+        R_TRY(this->ReceivePendingReadAheads());
+
         /* Try to perform an optimized send. */
         if (sizeof(request) + arg1_size + arg2_size < sizeof(m_packet_buffer)) {
             /* Setup our packet buffer. */
@@ -402,10 +412,182 @@ namespace ams::htcfs {
         return ResultSuccess();
     }
 
-    Result ClientImpl::OpenFile(s32 *out_handle, const char *path, fs::OpenMode mode, bool case_sensitive) {
-        /* Invalidate the cache manager. */
-        m_cache_manager.Invalidate();
+    Result ClientImpl::ReceivePendingReadAhead() {
+        /* Get the oldest outstanding read-ahead. */
+        AMS_ASSERT(m_pending_read_ahead_count > 0);
+        const auto pending = m_pending_read_aheads[m_pending_read_ahead_head];
+
+        /* Note that it's no longer outstanding. */
+        m_pending_read_ahead_head = (m_pending_read_ahead_head + 1) % MaxPendingReadAheadCount;
+        --m_pending_read_ahead_count;
+
+        /* Receive response from the host. */
+        Header response;
+        R_TRY(this->ReceiveFromRpcChannel(std::addressof(response), sizeof(response)));
+
+        /* Check the response header. */
+        R_TRY(this->CheckResponseHeader(response, PacketType::ReadFile));
+
+        /* If the read failed, there's nothing to cache; whoever reads the data will get the failure from the host. */
+        if (R_FAILED(ConvertHtcfsResult(response.params[0])) || R_FAILED(ConvertNativeResult(response.params[1]))) {
+            R_UNLESS(response.body_size == 0, htcfs::ResultUnexpectedResponseBodySize());
+            return ResultSuccess();
+        }
+
+        /* Check the body size. */
+        R_UNLESS(response.body_size >= 0,                                           htcfs::ResultUnexpectedResponseBodySize());
+        R_UNLESS(static_cast<size_t>(response.body_size) <= CacheManager::BlockSize, htcfs::ResultUnexpectedResponseBodySize());
+
+        /* Receive the file data. */
+        if (response.body_size > 0) {
+            R_TRY(this->ReceiveFromRpcChannel(m_packet_buffer, response.body_size));
+        }
+
+        /* Cache the data. */
+        const bool is_end = static_cast<size_t>(response.body_size) < CacheManager::BlockSize;
+        m_cache_manager.RecordBlock(pending.handle, pending.offset, m_packet_buffer, response.body_size, is_end);
+
+        /* If we reached the end of the file, there's no point reading further ahead. */
+        if (is_end) {
+            if (auto *state = this->FindReadAheadState(pending.handle); state != nullptr) {
+                state->reached_end = true;
+            }
+        }
+
+        return ResultSuccess();
+    }
+
+    Result ClientImpl::ReceivePendingReadAheads() {
+        /* Receive all outstanding read-aheads. */
+        while (m_pending_read_ahead_count > 0) {
+            R_TRY(this->ReceivePendingReadAhead());
+        }
+
+        return ResultSuccess();
+    }
+
+    Result ClientImpl::ReceivePendingReadAheads(s32 handle, s64 offset, s64 size) {
+        /* Find the newest outstanding read-ahead which overlaps the range. */
+        size_t count = 0;
+        for (size_t i = 0; i < m_pending_read_ahead_count; ++i) {
+            const auto &pending = m_pending_read_aheads[(m_pending_read_ahead_head + i) % MaxPendingReadAheadCount];
+            if (pending.handle == handle && pending.offset < offset + size && offset < pending.offset + static_cast<s64>(CacheManager::BlockSize)) {
+                count = i + 1;
+            }
+        }
+
+        /* Receive read-aheads up to and including it. */
+        for (size_t i = 0; i < count; ++i) {
+            R_TRY(this->ReceivePendingReadAhead());
+        }
+
+        return ResultSuccess();
+    }
+
+    void ClientImpl::ClearPendingReadAheads() {
+        /* Forget our outstanding read-aheads. */
+        m_pending_read_ahead_head  = 0;
+        m_pending_read_ahead_count = 0;
+    }
+
+    ClientImpl::ReadAheadState *ClientImpl::FindReadAheadState(s32 handle) {
+        for (auto &state : m_read_ahead_states) {
+            if (state.is_valid && state.handle == handle) {
+                return std::addressof(state);
+            }
+        }
+
+        return nullptr;
+    }
 
+    ClientImpl::ReadAheadState *ClientImpl::AcquireReadAheadState(s32 handle) {
+        /* Find the handle's existing state, if it has one. */
+        ReadAheadState *state = this->FindReadAheadState(handle);
+        if (state == nullptr) {
+            /* Prefer an unused state, and otherwise replace the least recently used one. */
+            for (auto &cur : m_read_ahead_states) {
+                if (!cur.is_valid) {
+                    state = std::addressof(cur);
+                    break;
+                }
+
+                if (state == nullptr || static_cast<s32>(cur.last_used - state->last_used) < 0) {
+                    state = std::addressof(cur);
+                }
+            }
+
+            /* Initialize the state. */
+            /* NOTE: Reads from the start of the file are treated as sequential. */
+            *state = {
+                .next_offset       = 0,
+                .read_ahead_offset = 0,
+                .last_used         = 0,
+                .handle            = handle,
+                .window            = 0,
+                .reached_end       = false,
+                .is_valid          = true,
+            };
+        }
+
+        /* Note that we used the state. */
+        state->last_used = ++m_read_ahead_use_counter;
+
+        return state;
+    }
+
+    void ClientImpl::UpdateReadAhead(s32 handle, s64 offset, s64 read_size, s64 requested_size) {
+        /* Get the handle's read-ahead state. */
+        ReadAheadState *state = this->AcquireReadAheadState(handle);
+
+        /* Grow our window while the file is read sequentially, and reset it otherwise. */
+        if (offset == state->next_offset) {
+            state->window = std::min(std::max(state->window * 2, 1), MaxReadAheadWindow);
+        } else {
+            state->window            = 0;
+            state->read_ahead_offset = 0;
+            state->reached_end       = false;
+        }
+
+        /* Update our expectation of the next read. */
+        state->next_offset       = offset + read_size;
+        state->read_ahead_offset = std::max(state->read_ahead_offset, state->next_offset);
+        state->reached_end       = state->reached_end || read_size < requested_size;
+
+        /* Make requests for the blocks in our window which we haven't requested yet. */
+        Header requests[MaxPendingReadAheadCount];
+        size_t request_count = 0;
+        const s64 read_ahead_end = state->next_offset + state->window * static_cast<s64>(CacheManager::BlockSize);
+        while (!state->reached_end && state->read_ahead_offset < read_ahead_end && m_pending_read_ahead_count + request_count < MaxPendingReadAheadCount) {
+            m_header_factory.MakeReadFileHeader(requests + request_count, handle, state->read_ahead_offset, CacheManager::BlockSize);
+            m_pending_read_aheads[(m_pending_read_ahead_head + m_pending_read_ahead_count + request_count) % MaxPendingReadAheadCount] = { state->read_ahead_offset, handle };
+
+            state->read_ahead_offset += CacheManager::BlockSize;
+            ++request_count;
+        }
+
+        /* Send our requests together, without waiting for their responses. */
+        if (request_count > 0) {
+            if (R_SUCCEEDED(this->SendToRpcChannel(requests, sizeof(requests[0]) * request_count))) {
+                m_pending_read_ahead_count += request_count;
+            } else {
+                this->InvalidateReadAhead(handle);
+            }
+        }
+    }
+
+    void ClientImpl::InvalidateReadAhead() {
+        for (auto &state : m_read_ahead_states) {
+            state.is_valid = false;
+        }
+    }
+
+    void ClientImpl::InvalidateReadAhead(s32 handle) {
+        if (auto *state = this->FindReadAheadState(handle); state != nullptr) {
+            state->is_valid = false;
+        }
+    }
+
+    Result ClientImpl::OpenFile(s32 *out_handle, const char *path, fs::OpenMode mode, bool case_sensitive) {
         /* Lock ourselves. */
         std::scoped_lock lk(m_mutex);
 
@@ -446,6 +628,10 @@ namespace ams::htcfs {
         /* Set our output handle. */
         *out_handle = response.params[2];
 
+        /* Ensure we have nothing cached from a previous use of the handle. */
+        m_cache_manager.Invalidate(response.params[2]);
+        this->InvalidateReadAhead(response.params[2]);
+
         /* If we have data to cache, cache it. */
         if (response.params[3]) {
             m_cache_manager.Record(response.params[4], m_packet_buffer, response.params[2], response.body_size);
@@ -1136,15 +1322,17 @@ namespace ams::htcfs {
     }
 
     Result ClientImpl::CloseFile(s32 handle) {
-        /* Invalidate the cache. */
-        m_cache_manager.Invalidate(handle);
-
         /* Lock ourselves. */
         std::scoped_lock lk(m_mutex);
 
         /* Initialize our rpc channel. */
         R_TRY(this->InitializeRpcChannel());
 
+        /* Receive any outstanding read-ahead data, and invalidate the cache. */
+        R_TRY(this->ReceivePendingReadAheads());
+        m_cache_manager.Invalidate(handle);
+        this->InvalidateReadAhead(handle);
+
         /* Create space for request and response. */
         Header request, response;
 
@@ -1180,11 +1368,17 @@ namespace ams::htcfs {
 
         /* Try to read from our cache. */
         if (util::IsIntValueRepresentable<size_t>(offset) && util::IsIntValueRepresentable<size_t>(buffer_size)) {
+            /* If we've already requested the data, wait for it to arrive. */
+            R_TRY(this->ReceivePendingReadAheads(handle, offset, buffer_size));
+
             size_t read_size;
             if (m_cache_manager.ReadFile(std::addressof(read_size), buffer, handle, static_cast<size_t>(offset), static_cast<size_t>(buffer_size))) {
                 AMS_ASSERT(util::IsIntValueRepresentable<s64>(read_size));
 
                 *out = static_cast<s64>(read_size);
+
+                /* Keep our read-ahead window full. */
+                this->UpdateReadAhead(handle, offset, *out, buffer_size);
                 return ResultSuccess();
             }
         }
@@ -1227,6 +1421,9 @@ namespace ams::htcfs {
         /* Set the output size. */
         *out = response.body_size;
 
+        /* If the file is being read sequentially, read ahead. */
+        this->UpdateReadAhead(handle, offset, *out, buffer_size);
+
         return ResultSuccess();
     }
 
@@ -1288,15 +1485,18 @@ namespace ams::htcfs {
     }
 
     Result ClientImpl::WriteFile(const void *buffer, s32 handle, s64 offset, s64 buffer_size, fs::WriteOption option) {
-        /* Invalidate the cache. */
-        m_cache_manager.Invalidate(handle);
-
         /* Lock ourselves. */
         std::scoped_lock lk(m_mutex);
 
         /* Initialize our rpc channel. */
         R_TRY(this->InitializeRpcChannel());
 
+        /* Receive any outstanding read-ahead data, and invalidate the cache. */
+        /* NOTE: Other handles may refer to the same file, so everything must be invalidated. */
+        R_TRY(this->ReceivePendingReadAheads());
+        m_cache_manager.Invalidate();
+        this->InvalidateReadAhead();
+
         /* Create space for request and response. */
         Header request, response;
 
@@ -1322,15 +1522,18 @@ namespace ams::htcfs {
     }
 
     Result ClientImpl::WriteFileLarge(const void *buffer, s32 handle, s64 offset, s64 buffer_size, fs::WriteOption option) {
-        /* Invalidate the cache. */
-        m_cache_manager.Invalidate(handle);
-
         /* Lock ourselves. */
         std::scoped_lock lk(m_mutex);
 
         /* Initialize our rpc channel. */
         R_TRY(this->InitializeRpcChannel());
 
+        /* Receive any outstanding read-ahead data, and invalidate the cache. */
+        /* NOTE: Other handles may refer to the same file, so everything must be invalidated. */
+        R_TRY(this->ReceivePendingReadAheads());
+        m_cache_manager.Invalidate();
+        this->InvalidateReadAhead();
+
         /* Create space for request and response. */
         Header request, response;
 
@@ -1420,15 +1623,18 @@ namespace ams::htcfs {
     }
 
     Result ClientImpl::SetFileSize(s64 size, s32 handle) {
-        /* Invalidate the cache. */
-        m_cache_manager.Invalidate(handle);
-
         /* Lock ourselves. */
         std::scoped_lock lk(m_mutex);
 
         /* Initialize our rpc channel. */
         R_TRY(this->InitializeRpcChannel());
 
+        /* Receive any outstanding read-ahead data, and invalidate the cache. */
+        /* NOTE: Other handles may refer to the same file, so everything must be invalidated. */
+        R_TRY(this->ReceivePendingReadAheads());
+        m_cache_manager.Invalidate();
+        this->InvalidateReadAhead();
+
         /* Create space for request and response. */
         Header request, response;
 
@@ -26,6 +26,25 @@ namespace ams::htcfs {
     class ClientImpl {
         public:
             static constexpr size_t MaxPacketBodySize = htclow::DefaultChannelConfig.max_packet_size - sizeof(htclow::PacketHeader);
+
+            static constexpr size_t MaxPendingReadAheadCount = 4;
+            static constexpr size_t MaxReadAheadStateCount   = 8;
+            static constexpr s32 MaxReadAheadWindow          = 4;
+        private:
+            struct PendingReadAhead {
+                s64 offset;
+                s32 handle;
+            };
+
+            struct ReadAheadState {
+                s64 next_offset;
+                s64 read_ahead_offset;
+                u32 last_used;
+                s32 handle;
+                s32 window;
+                bool reached_end;
+                bool is_valid;
+            };
         private:
             u8 m_receive_buffer[0x1C040];
             u8 m_send_buffer[0x1C040];
@@ -40,6 +59,11 @@ namespace ams::htcfs {
             bool m_connected;
             os::ThreadType m_monitor_thread;
             os::Event m_event;
+            PendingReadAhead m_pending_read_aheads[MaxPendingReadAheadCount];
+            size_t m_pending_read_ahead_head;
+            size_t m_pending_read_ahead_count;
+            ReadAheadState m_read_ahead_states[MaxReadAheadStateCount];
+            u32 m_read_ahead_use_counter;
         private:
             static void ThreadEntry(void *arg) { static_cast<ClientImpl *>(arg)->ThreadBody(); }
 
@@ -121,6 +145,17 @@ namespace ams::htcfs {
             Result SendRequest(const Header &request, const void *arg1, size_t arg1_size) { return this->SendRequest(request, arg1, arg1_size, nullptr, 0); }
             Result SendRequest(const Header &request, const void *arg1, size_t arg1_size, const void *arg2, size_t arg2_size);
 
+            Result ReceivePendingReadAhead();
+            Result ReceivePendingReadAheads();
+            Result ReceivePendingReadAheads(s32 handle, s64 offset, s64 size);
+            void ClearPendingReadAheads();
+
+            ReadAheadState *FindReadAheadState(s32 handle);
+            ReadAheadState *AcquireReadAheadState(s32 handle);
+            void UpdateReadAhead(s32 handle, s64 offset, s64 read_size, s64 requested_size);
+            void InvalidateReadAhead();
+            void InvalidateReadAhead(s32 handle);
+
             void InitializeDataChannelForReceive(void *dst, size_t size);
             void InitializeDataChannelForSend(const void *src, size_t size);
             void FinalizeDataChannel();
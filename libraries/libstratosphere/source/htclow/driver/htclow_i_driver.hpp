@@ -29,6 +29,8 @@ namespace ams::htclow::driver {
             virtual void CancelSendReceive()                   = 0;
             virtual void Suspend()                             = 0;
             virtual void Resume()                              = 0;
+
+            virtual bool IsCoalescedSendSupported()            = 0;
     };
 
 }
@@ -71,6 +71,11 @@ namespace ams::htclow::driver {
             virtual void CancelSendReceive() override;
             virtual void Suspend() override;
             virtual void Resume() override;
+
+            virtual bool IsCoalescedSendSupported() override {
+                /* Packets are read back out of a stream, so several may be sent at once. */
+                return true;
+            }
     };
 
 }
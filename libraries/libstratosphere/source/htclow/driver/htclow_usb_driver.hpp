@@ -38,6 +38,11 @@ namespace ams::htclow::driver {
             virtual void CancelSendReceive() override;
             virtual void Suspend() override;
             virtual void Resume() override;
+
+            virtual bool IsCoalescedSendSupported() override {
+                /* Packet headers and bodies are received as separate, exactly sized transfers, so packets must be sent individually. */
+                return false;
+            }
     };
 
 }
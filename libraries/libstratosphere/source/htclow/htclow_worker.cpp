@@ -22,10 +22,25 @@ namespace ams::htclow {
 
         constexpr inline size_t ThreadStackSize = 4_KB;
 
+        /* When coalescing, mux packets are gathered into our send buffer until there's no room for a reasonably sized packet. */
+        constexpr inline size_t MinCoalescedPacketBodySize = 4_KB;
+
+        /* The time spent waiting for further packets before a partial flush is bounded, to keep latency reasonable. */
+        constexpr inline TimeSpan MaxSendFlushLatency = TimeSpan::FromMilliSeconds(1);
+
+        TimeSpan GetSendFlushLatency() {
+            u32 latency_us = 0;
+            if (settings::fwdbg::GetSettingsItemValue(std::addressof(latency_us), sizeof(latency_us), "atmosphere", "htclow_send_flush_latency_us") != sizeof(latency_us)) {
+                return TimeSpan(0);
+            }
+
+            return std::min(TimeSpan::FromMicroSeconds(latency_us), MaxSendFlushLatency);
+        }
+
     }
 
     Worker::Worker(mem::StandardAllocator *allocator, mux::Mux *mux, ctrl::HtcctrlService *ctrl_srv)
-        : m_thread_stack_size(ThreadStackSize), m_allocator(allocator), m_mux(mux), m_service(ctrl_srv), m_driver(nullptr), m_event(os::EventClearMode_ManualClear), m_cancelled(false)
+        : m_thread_stack_size(ThreadStackSize), m_allocator(allocator), m_mux(mux), m_service(ctrl_srv), m_driver(nullptr), m_event(os::EventClearMode_ManualClear), m_send_flush_latency(0), m_cancelled(false)
     {
         /* Allocate stacks. */
         m_receive_thread_stack = m_allocator->Allocate(m_thread_stack_size, os::ThreadStackAlignment);
@@ -43,6 +58,9 @@ namespace ams::htclow {
         /* Clear our event. */
         m_event.Clear();
 
+        /* Load our send flush latency. */
+        m_send_flush_latency = GetSendFlushLatency();
+
         /* Create our threads. */
         R_ABORT_UNLESS(os::CreateThread(std::addressof(m_receive_thread), ReceiveThreadEntry, this, m_receive_thread_stack, ThreadStackSize, AMS_GET_SYSTEM_THREAD_PRIORITY(htc, HtclowReceive)));
         R_ABORT_UNLESS(os::CreateThread(std::addressof(m_send_thread),    SendThreadEntry,    this, m_send_thread_stack,    ThreadStackSize, AMS_GET_SYSTEM_THREAD_PRIORITY(htc, HtclowSend)));
@@ -159,13 +177,7 @@ namespace ams::htclow {
                 os::ClearEvent(m_mux->GetSendPacketEvent());
 
                 /* While we have packets, send them. */
-                auto *packet_header = reinterpret_cast<PacketHeader *>(m_send_buffer);
-                auto *packet_body   = reinterpret_cast<PacketBody *>(m_send_buffer + sizeof(*packet_header));
-                int body_size;
-                while (m_mux->QuerySendPacket(packet_header, packet_body, std::addressof(body_size))) {
-                    R_TRY(m_driver->Send(packet_header, body_size + sizeof(*packet_header)));
-                    m_mux->RemovePacket(*packet_header);
-                }
+                R_TRY(this->ProcessSendMuxPackets());
             } else {
                 /* Our event. */
 
@@ -178,4 +190,50 @@ namespace ams::htclow {
 
     }
 
+    Result Worker::ProcessSendMuxPackets() {
+        /* If our driver can't accept several packets at once, send them one at a time. */
+        if (!m_driver->IsCoalescedSendSupported()) {
+            auto *packet_header = reinterpret_cast<PacketHeader *>(m_send_buffer);
+            auto *packet_body   = reinterpret_cast<PacketBody *>(m_send_buffer + sizeof(*packet_header));
+            int body_size;
+            while (m_mux->QuerySendPacket(packet_header, packet_body, std::addressof(body_size))) {
+                R_TRY(m_driver->Send(packet_header, body_size + sizeof(*packet_header)));
+                m_mux->RemovePacket(*packet_header);
+            }
+
+            return ResultSuccess();
+        }
+
+        /* Gather as many packets as we can into our send buffer, and send them to the driver together. */
+        while (true) {
+            /* Query packets into our send buffer. */
+            size_t send_size = m_mux->QuerySendPackets(m_send_buffer, sizeof(m_send_buffer), MinCoalescedPacketBodySize);
+
+            /* If we have nothing to send, we're done. */
+            R_SUCCEED_IF(send_size == 0);
+
+            /* If we have room, we may wait a short time for more packets to become ready. */
+            /* Nothing has been removed yet, so if more packets arrive we can simply query again. */
+            if (m_send_flush_latency > TimeSpan(0) && sizeof(m_send_buffer) - send_size >= sizeof(PacketHeader) + MinCoalescedPacketBodySize) {
+                if (os::TimedWaitEvent(m_mux->GetSendPacketEvent(), m_send_flush_latency)) {
+                    os::ClearEvent(m_mux->GetSendPacketEvent());
+                    send_size = m_mux->QuerySendPackets(m_send_buffer, sizeof(m_send_buffer), MinCoalescedPacketBodySize);
+                    R_SUCCEED_IF(send_size == 0);
+                }
+            }
+
+            /* Send the gathered packets. */
+            R_TRY(m_driver->Send(m_send_buffer, send_size));
+
+            /* Now that they've been sent, remove the packets. */
+            for (size_t offset = 0; offset < send_size; /* ... */) {
+                PacketHeader packet_header;
+                std::memcpy(std::addressof(packet_header), m_send_buffer + offset, sizeof(packet_header));
+
+                m_mux->RemovePacket(packet_header);
+                offset += sizeof(packet_header) + packet_header.body_size;
+            }
+        }
+    }
+
 }
@@ -36,6 +36,7 @@ namespace ams::htclow {
             os::ThreadType m_receive_thread;
             os::ThreadType m_send_thread;
             os::Event m_event;
+            TimeSpan m_send_flush_latency;
             void *m_receive_thread_stack;
             void *m_send_thread_stack;
             bool m_cancelled;
@@ -61,6 +62,7 @@ namespace ams::htclow {
         private:
             Result ProcessReceive();
             Result ProcessSend();
+            Result ProcessSendMuxPackets();
 
             Result ProcessReceive(const ctrl::HtcctrlPacketHeader &header);
             Result ProcessReceive(const PacketHeader &header);
@@ -94,7 +94,7 @@ namespace ams::htclow::mux {
         for (auto &pair : m_channel_impl_map.GetMap()) {
             /* Get the current channel impl. */
             /* See if the channel has something for us to send. */
-            if (m_channel_impl_map[pair.second].QuerySendPacket(header, body, out_body_size)) {
+            if (m_channel_impl_map[pair.second].QuerySendPacket(header, body, out_body_size, sizeof(*body))) {
                 return this->IsSendable(header->packet_type);
             }
         }
@@ -102,6 +102,53 @@ namespace ams::htclow::mux {
         return false;
     }
 
+    size_t Mux::QuerySendPackets(void *dst, size_t dst_size, size_t min_body_size) {
+        /* Validate pre-conditions. */
+        AMS_ASSERT(dst_size >= sizeof(PacketHeader) + sizeof(PacketBody));
+
+        /* Lock ourselves. */
+        std::scoped_lock lk(m_mutex);
+
+        /* NOTE: Packets are only queried here, and must be removed by the caller once they have been sent. */
+        /* Because of this, at most one packet is queried from each source; a second query would return the same packet. */
+        u8 * const dst_u8 = static_cast<u8 *>(dst);
+        size_t query_size = 0;
+
+        /* Check for an error packet. */
+        if (auto *error_packet = m_global_send_buffer.GetNextPacket(); error_packet != nullptr) {
+            std::memcpy(dst_u8, error_packet->GetHeader(), sizeof(PacketHeader));
+            query_size += sizeof(PacketHeader);
+        }
+
+        /* Iterate the map, gathering a packet from each channel while we have room for one. */
+        for (auto &pair : m_channel_impl_map.GetMap()) {
+            /* Check that we have room for a reasonably sized packet. */
+            if (dst_size - query_size < sizeof(PacketHeader) + min_body_size) {
+                break;
+            }
+
+            /* See if the channel has something for us to send, copying its body directly into place. */
+            /* NOTE: The header is queried separately, as its position in the destination may be unaligned. */
+            PacketHeader header;
+            auto *body = reinterpret_cast<PacketBody *>(dst_u8 + query_size + sizeof(header));
+            int body_size;
+            if (!m_channel_impl_map[pair.second].QuerySendPacket(std::addressof(header), body, std::addressof(body_size), dst_size - query_size - sizeof(header))) {
+                continue;
+            }
+
+            /* If the packet isn't sendable, we're done. */
+            if (!this->IsSendable(header.packet_type)) {
+                break;
+            }
+
+            /* Copy the header into place. */
+            std::memcpy(dst_u8 + query_size, std::addressof(header), sizeof(header));
+            query_size += sizeof(header) + body_size;
+        }
+
+        return query_size;
+    }
+
     void Mux::RemovePacket(const PacketHeader &header) {
         /* Lock ourselves. */
         std::scoped_lock lk(m_mutex);
@@ -144,9 +144,9 @@ namespace ams::htclow::mux {
         return ResultSuccess();
     }
 
-    bool ChannelImpl::QuerySendPacket(PacketHeader *header, PacketBody *body, int *out_body_size) {
+    bool ChannelImpl::QuerySendPacket(PacketHeader *header, PacketBody *body, int *out_body_size, size_t max_body_size) {
         /* Check our send buffer. */
-        if (m_send_buffer.QueryNextPacket(header, body, out_body_size, m_cur_max_data, m_total_send_size, m_share.has_value(), m_share.value_or(0))) {
+        if (m_send_buffer.QueryNextPacket(header, body, out_body_size, max_body_size, m_cur_max_data, m_total_send_size, m_share.has_value(), m_share.value_or(0))) {
             /* Update tracking variables. */
             if (header->packet_type == PacketType_Data) {
                 m_prev_max_data = m_cur_max_data;
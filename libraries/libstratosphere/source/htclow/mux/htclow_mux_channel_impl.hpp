@@ -60,7 +60,7 @@ namespace ams::htclow::mux {
 
             Result ProcessReceivePacket(const PacketHeader &header, const void *body, size_t body_size);
 
-            bool QuerySendPacket(PacketHeader *header, PacketBody *body, int *out_body_size);
+            bool QuerySendPacket(PacketHeader *header, PacketBody *body, int *out_body_size, size_t max_body_size);
 
             void RemovePacket(const PacketHeader &header);
 
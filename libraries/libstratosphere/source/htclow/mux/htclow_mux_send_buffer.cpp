@@ -73,9 +73,14 @@ namespace ams::htclow::mux {
         *out_body_size = body_size;
     }
 
-    bool SendBuffer::QueryNextPacket(PacketHeader *header, PacketBody *body, int *out_body_size, u64 max_data, u64 total_send_size, bool has_share, u64 share) {
+    bool SendBuffer::QueryNextPacket(PacketHeader *header, PacketBody *body, int *out_body_size, size_t max_body_size, u64 max_data, u64 total_send_size, bool has_share, u64 share) {
         /* Check for a max data packet. */
         if (!m_packet_list.empty()) {
+            /* Prior packets can't be split, so they must fit in their entirety. */
+            if (static_cast<size_t>(m_packet_list.front().GetBodySize()) > max_body_size) {
+                return false;
+            }
+
             this->CopyPacket(header, body, out_body_size, m_packet_list.front());
             return true;
         }
@@ -98,8 +103,8 @@ namespace ams::htclow::mux {
             return false;
         }
 
-        /* We're additionally bound by the actual packet size. */
-        const auto data_size = std::min(sendable_size, m_max_packet_size);
+        /* We're additionally bound by the actual packet size, and by the space the caller has for the body. */
+        const auto data_size = std::min(std::min(sendable_size, m_max_packet_size), max_body_size);
 
         /* Make data packet header. */
         this->MakeDataPacketHeader(header, data_size, m_version, max_data, offset);
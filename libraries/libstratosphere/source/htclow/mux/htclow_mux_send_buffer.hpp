@@ -50,7 +50,7 @@ namespace ams::htclow::mux {
             void SetVersion(s16 version);
             void SetFlowControlEnabled(bool en);
 
-            bool QueryNextPacket(PacketHeader *header, PacketBody *body, int *out_body_size, u64 max_data, u64 total_send_size, bool has_share, u64 share);
+            bool QueryNextPacket(PacketHeader *header, PacketBody *body, int *out_body_size, size_t max_body_size, u64 max_data, u64 total_send_size, bool has_share, u64 share);
 
             void AddPacket(std::unique_ptr<Packet, PacketDeleter> ptr);
             void RemovePacket(const PacketHeader &header);
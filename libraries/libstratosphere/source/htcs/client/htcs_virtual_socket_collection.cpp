@@ -24,6 +24,16 @@ namespace ams::htcs::client {
         constexpr inline s32 InvalidSocket = -1;
         constexpr inline s32 InvalidPrimitive = -1;
 
+        /* Readiness reported by the host remains true until we operate on the socket. */
+        enum Readiness : u8 {
+            Readiness_Read      = (1 << 0),
+            Readiness_Write     = (1 << 1),
+            Readiness_Exception = (1 << 2),
+        };
+
+        /* Selects answered from known readiness are bounded, so that other sockets are still checked with the host. */
+        constexpr inline s32 LocalSelectCountMax = 8;
+
     }
 
     /* Declare client functions. */
@@ -53,6 +63,8 @@ namespace ams::htcs::client {
         s32 m_fcntl_command;
         s32 m_fcntl_value;
         bool m_blocking;
+        u8 m_readiness;
+        u32 m_readiness_sequence;
 
 
         VirtualSocket() {
@@ -69,6 +81,9 @@ namespace ams::htcs::client {
             m_socket    = nullptr;
             m_blocking  = true;
             m_do_bind   = false;
+            m_readiness = 0;
+
+            m_readiness_sequence = 0;
 
             std::memset(std::addressof(m_address), 0, sizeof(m_address));
 
@@ -155,6 +170,8 @@ namespace ams::htcs::client {
           m_list_count(0),
           m_list_size(0),
           m_next_id(1),
+          m_local_select_count(0),
+          m_readiness_sequence(0),
           m_mutex()
     {
         /* ... */
@@ -313,6 +330,11 @@ namespace ams::htcs::client {
     }
 
     s32 VirtualSocketCollection::Accept(s32 id, htcs::SockAddrHtcs *address, s32 &error_code) {
+        /* The operation may consume any readiness we know of. */
+        /* NOTE: Readiness is also cleared once the operation completes, in case a select ran concurrently with it. */
+        this->ClearReadiness(id);
+        ON_SCOPE_EXIT { this->ClearReadiness(id); };
+
         /* Setup result/error code. */
         s32 res    = -1;
         error_code = 0;
@@ -420,6 +442,11 @@ namespace ams::htcs::client {
     }
 
     s32 VirtualSocketCollection::Shutdown(s32 id, s32 how, s32 &error_code) {
+        /* The operation may consume any readiness we know of. */
+        /* NOTE: Readiness is also cleared once the operation completes, in case a select ran concurrently with it. */
+        this->ClearReadiness(id);
+        ON_SCOPE_EXIT { this->ClearReadiness(id); };
+
         /* Setup result/error code. */
         s32 res    = -1;
         error_code = 0;
@@ -438,6 +465,11 @@ namespace ams::htcs::client {
     }
 
     ssize_t VirtualSocketCollection::Recv(s32 id, void *buffer, size_t buffer_size, s32 flags, s32 &error_code) {
+        /* The operation may consume any readiness we know of. */
+        /* NOTE: Readiness is also cleared once the operation completes, in case a select ran concurrently with it. */
+        this->ClearReadiness(id);
+        ON_SCOPE_EXIT { this->ClearReadiness(id); };
+
         /* Setup result/error code. */
         ssize_t res = -1;
         error_code  = 0;
@@ -459,6 +491,11 @@ namespace ams::htcs::client {
     }
 
     ssize_t VirtualSocketCollection::Send(s32 id, const void *buffer, size_t buffer_size, s32 flags, s32 &error_code) {
+        /* The operation may consume any readiness we know of. */
+        /* NOTE: Readiness is also cleared once the operation completes, in case a select ran concurrently with it. */
+        this->ClearReadiness(id);
+        ON_SCOPE_EXIT { this->ClearReadiness(id); };
+
         /* Setup result/error code. */
         ssize_t res = -1;
         error_code  = 0;
@@ -533,7 +570,7 @@ namespace ams::htcs::client {
 
         /* Perform the select. */
         if (num_read + num_write + num_except > 0) {
-            res = select(read_primitives, num_read, write_primitives, num_write, except_primitives, num_except, timeout, error_code);
+            res = this->SelectImpl(read_primitives, num_read, write_primitives, num_write, except_primitives, num_except, timeout, error_code);
 
             /* Set the socket primitives. */
             this->SetSockets(read, read_primitives, num_read);
@@ -546,6 +583,86 @@ namespace ams::htcs::client {
         return res;
     }
 
+    s32 VirtualSocketCollection::Poll(htcs::PollFd *fds, s32 count, s32 timeout_ms, s32 &error_code) {
+        /* Setup result/error code. */
+        s32 res    = -1;
+        error_code = 0;
+
+        /* Check the count. */
+        if (count <= 0 || count > SocketCountMax) {
+            error_code = HTCS_EINVAL;
+            return res;
+        }
+
+        /* Declare buffers. */
+        s32 primitives[SocketCountMax];
+        s32 read_primitives[SocketCountMax];
+        s32 write_primitives[SocketCountMax];
+        s32 except_primitives[SocketCountMax];
+        s32 num_read   = 0;
+        s32 num_write  = 0;
+        s32 num_except = 0;
+
+        /* Get the primitives for each fd. */
+        for (auto i = 0; i < count; ++i) {
+            fds[i].revents = 0;
+
+            primitives[i] = this->GetPrimitive(fds[i].fd, error_code);
+            if (error_code != HTCS_ENONE) {
+                return res;
+            }
+
+            if (primitives[i] != InvalidPrimitive) {
+                if (fds[i].events & HTCS_POLLIN) {
+                    read_primitives[num_read++] = primitives[i];
+                }
+                if (fds[i].events & HTCS_POLLOUT) {
+                    write_primitives[num_write++] = primitives[i];
+                }
+                if (fds[i].events & HTCS_POLLPRI) {
+                    except_primitives[num_except++] = primitives[i];
+                }
+            }
+        }
+
+        /* Check that we have something to wait on. */
+        if (num_read + num_write + num_except == 0) {
+            error_code = HTCS_EINVAL;
+            return res;
+        }
+
+        /* Perform the select. */
+        htcs::TimeVal timeout = { .tv_sec = timeout_ms / 1000, .tv_usec = (timeout_ms % 1000) * 1000 };
+        res = this->SelectImpl(read_primitives, num_read, write_primitives, num_write, except_primitives, num_except, timeout_ms >= 0 ? std::addressof(timeout) : nullptr, error_code);
+        if (res <= 0) {
+            return res;
+        }
+
+        /* Set the returned events. */
+        const auto Contains = [](const s32 *list, s32 num, s32 primitive) ALWAYS_INLINE_LAMBDA { return std::find(list, list + num, primitive) != list + num; };
+
+        res = 0;
+        for (auto i = 0; i < count; ++i) {
+            if (primitives[i] != InvalidPrimitive) {
+                if ((fds[i].events & HTCS_POLLIN) && Contains(read_primitives, num_read, primitives[i])) {
+                    fds[i].revents |= HTCS_POLLIN;
+                }
+                if ((fds[i].events & HTCS_POLLOUT) && Contains(write_primitives, num_write, primitives[i])) {
+                    fds[i].revents |= HTCS_POLLOUT;
+                }
+                if ((fds[i].events & HTCS_POLLPRI) && Contains(except_primitives, num_except, primitives[i])) {
+                    fds[i].revents |= HTCS_POLLPRI;
+                }
+
+                if (fds[i].revents != 0) {
+                    ++res;
+                }
+            }
+        }
+
+        return res;
+    }
+
     s32 VirtualSocketCollection::CreateId() {
         /* Lock ourselves. */
         std::scoped_lock lk(m_mutex);
@@ -589,12 +706,14 @@ namespace ams::htcs::client {
             }
 
             /* Set the socket in the list. */
-            m_socket_list[index + 1].m_id     = id;
-            m_socket_list[index + 1].m_socket = socket;
+            m_socket_list[index + 1].m_id                 = id;
+            m_socket_list[index + 1].m_socket             = socket;
+            m_socket_list[index + 1].m_readiness_sequence = ++m_readiness_sequence;
         } else {
             /* Set the socket in the list. */
-            m_socket_list[0].m_id     = id;
-            m_socket_list[0].m_socket = socket;
+            m_socket_list[0].m_id                 = id;
+            m_socket_list[0].m_socket             = socket;
+            m_socket_list[0].m_readiness_sequence = ++m_readiness_sequence;
         }
 
         /* Increment our count. */
@@ -729,6 +848,47 @@ namespace ams::htcs::client {
         return new_socket;
     }
 
+    s32 VirtualSocketCollection::GetPrimitive(s32 id, s32 &error_code) {
+        /* Clear the error code. */
+        error_code = 0;
+
+        /* Find the fd's primitive. */
+        s32 primitive = InvalidPrimitive;
+        s32 index;
+        {
+            std::scoped_lock lk(m_mutex);
+            if (index = this->Find(id, std::addressof(error_code)); index >= 0) {
+                /* Get the primitive, if necessary. */
+                if (m_socket_list[index].m_primitive == InvalidPrimitive && m_socket_list[index].m_socket != nullptr) {
+                    m_socket_list[index].m_socket->GetPrimitive(std::addressof(m_socket_list[index].m_primitive));
+                }
+
+                primitive = m_socket_list[index].m_primitive;
+            }
+        }
+
+        /* Check that an error didn't occur. */
+        if (error_code != HTCS_ENONE) {
+            return InvalidPrimitive;
+        }
+
+        /* If the primitive is invalid, try to realize the socket. */
+        if (primitive == InvalidPrimitive) {
+            if (this->RealizeSocket(id) != nullptr) {
+                std::scoped_lock lk(m_mutex);
+
+                /* Get the primitive. */
+                if (index = this->Find(id, std::addressof(error_code)); index >= 0) {
+                    m_socket_list[index].m_socket->GetPrimitive(std::addressof(m_socket_list[index].m_primitive));
+
+                    primitive = m_socket_list[index].m_primitive;
+                }
+            }
+        }
+
+        return primitive;
+    }
+
     s32 VirtualSocketCollection::GetSockets(s32 * const out_primitives, htcs::FdSet *set, s32 &error_code) {
         /* Clear the error code. */
         error_code = 0;
@@ -743,44 +903,13 @@ namespace ams::htcs::client {
                 }
 
                 /* Find the fd's primitive. */
-                s32 primitive = InvalidPrimitive;
-                s32 index;
-                {
-                    std::scoped_lock lk(m_mutex);
-                    if (index = this->Find(set->fds[i], std::addressof(error_code)); index >= 0) {
-                        /* Get the primitive, if necessary. */
-                        if (m_socket_list[index].m_primitive == InvalidPrimitive && m_socket_list[index].m_socket != nullptr) {
-                            m_socket_list[index].m_socket->GetPrimitive(std::addressof(m_socket_list[index].m_primitive));
-                        }
-
-                        primitive = m_socket_list[index].m_primitive;
-                    }
-                }
+                const s32 primitive = this->GetPrimitive(set->fds[i], error_code);
 
                 /* Check that an error didn't occur. */
                 if (error_code != HTCS_ENONE) {
                     return 0;
                 }
 
-                /* If the primitive is invalid, try to realize the socket. */
-                if (primitive == InvalidPrimitive) {
-                    if (this->RealizeSocket(set->fds[i]) != nullptr) {
-                        std::scoped_lock lk(m_mutex);
-
-                        /* Get the primitive. */
-                        if (index = this->Find(set->fds[i], std::addressof(error_code)); index >= 0) {
-                            m_socket_list[index].m_socket->GetPrimitive(std::addressof(m_socket_list[index].m_primitive));
-
-                            primitive = m_socket_list[index].m_primitive;
-                        }
-                    }
-
-                    /* Check that an error didn't occur. */
-                    if (error_code != HTCS_ENONE) {
-                        return 0;
-                    }
-                }
-
                 /* Set the output primitive. */
                 if (primitive != InvalidPrimitive) {
                     out_primitives[count++] = primitive;
@@ -807,6 +936,127 @@ namespace ams::htcs::client {
         }
     }
 
+    s32 VirtualSocketCollection::SelectImpl(s32 * const read, s32 num_read, s32 * const write, s32 num_write, s32 * const except, s32 num_except, htcs::TimeVal *timeout, s32 &error_code) {
+        /* If we already know that some of the sockets are ready, we don't need to ask the host. */
+        if (s32 res; this->SelectKnownReadySockets(std::addressof(res), read, num_read, write, num_write, except, num_except)) {
+            error_code = HTCS_ENONE;
+            return res;
+        }
+
+        /* Snapshot our sockets' readiness sequences, so that we can tell if they're operated on while the host selects. */
+        ReadinessSnapshotEntry snapshot[htcs::SocketCountMax];
+        const s32 snapshot_count = this->SnapshotReadiness(snapshot, util::size(snapshot));
+
+        /* Perform the select on the host. */
+        const s32 res = select(read, num_read, write, num_write, except, num_except, timeout, error_code);
+
+        /* Remember which sockets the host reported as ready. */
+        if (res > 0) {
+            this->RecordReadiness(read, num_read, Readiness_Read, snapshot, snapshot_count);
+            this->RecordReadiness(write, num_write, Readiness_Write, snapshot, snapshot_count);
+            this->RecordReadiness(except, num_except, Readiness_Exception, snapshot, snapshot_count);
+        }
+
+        return res;
+    }
+
+    bool VirtualSocketCollection::SelectKnownReadySockets(s32 *out, s32 * const read, s32 num_read, s32 * const write, s32 num_write, s32 * const except, s32 num_except) {
+        /* Lock ourselves. */
+        std::scoped_lock lk(m_mutex);
+
+        /* If we've answered from known readiness too many times in a row, let the host check all the sockets. */
+        if (m_local_select_count >= LocalSelectCountMax) {
+            m_local_select_count = 0;
+            return false;
+        }
+
+        /* Check whether any of the sockets are known to be ready. */
+        const auto IsKnownReady = [&](s32 primitive, u8 readiness) ALWAYS_INLINE_LAMBDA {
+            const auto index = this->FindByPrimitive(primitive);
+            return index >= 0 && (m_socket_list[index].m_readiness & readiness) != 0;
+        };
+
+        const auto HasKnownReady = [&](const s32 *primitives, s32 count, u8 readiness) ALWAYS_INLINE_LAMBDA {
+            for (auto i = 0; i < count; ++i) {
+                if (IsKnownReady(primitives[i], readiness)) {
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        if (!HasKnownReady(read, num_read, Readiness_Read) && !HasKnownReady(write, num_write, Readiness_Write) && !HasKnownReady(except, num_except, Readiness_Exception)) {
+            m_local_select_count = 0;
+            return false;
+        }
+
+        /* Keep only the ready sockets, in the same form as the host's output. */
+        const auto KeepKnownReady = [&](s32 * const primitives, s32 count, u8 readiness) ALWAYS_INLINE_LAMBDA {
+            s32 ready_count = 0;
+            for (auto i = 0; i < count; ++i) {
+                if (IsKnownReady(primitives[i], readiness)) {
+                    primitives[ready_count++] = primitives[i];
+                }
+            }
+            std::fill(primitives + ready_count, primitives + count, 0);
+            return ready_count;
+        };
+
+        *out = KeepKnownReady(read, num_read, Readiness_Read) + KeepKnownReady(write, num_write, Readiness_Write) + KeepKnownReady(except, num_except, Readiness_Exception);
+        ++m_local_select_count;
+        return true;
+    }
+
+    s32 VirtualSocketCollection::SnapshotReadiness(ReadinessSnapshotEntry *out, s32 max_count) {
+        /* Lock ourselves. */
+        std::scoped_lock lk(m_mutex);
+
+        /* Copy out the sequence of each realized socket. */
+        s32 count = 0;
+        for (auto i = 0; i < m_list_count && count < max_count; ++i) {
+            if (m_socket_list[i].m_primitive != InvalidPrimitive) {
+                out[count++] = { m_socket_list[i].m_primitive, m_socket_list[i].m_readiness_sequence };
+            }
+        }
+
+        return count;
+    }
+
+    void VirtualSocketCollection::RecordReadiness(const s32 *primitives, s32 count, u8 readiness, const ReadinessSnapshotEntry *snapshot, s32 snapshot_count) {
+        /* Lock ourselves. */
+        std::scoped_lock lk(m_mutex);
+
+        /* Determine whether a socket has been operated on since the snapshot was taken. */
+        const auto IsUnchanged = [&](const VirtualSocket &socket) ALWAYS_INLINE_LAMBDA {
+            for (auto i = 0; i < snapshot_count; ++i) {
+                if (snapshot[i].primitive == socket.m_primitive) {
+                    return snapshot[i].sequence == socket.m_readiness_sequence;
+                }
+            }
+            return false;
+        };
+
+        /* Mark each reported socket as ready. */
+        /* NOTE: The host's output is terminated by zero entries. */
+        /* NOTE: If the socket was operated on during the host's select, the host's readiness may already be stale. */
+        for (auto i = 0; i < count && primitives[i] != 0; ++i) {
+            if (const auto index = this->FindByPrimitive(primitives[i]); index >= 0 && IsUnchanged(m_socket_list[index])) {
+                m_socket_list[index].m_readiness |= readiness;
+            }
+        }
+    }
+
+    void VirtualSocketCollection::ClearReadiness(s32 id) {
+        /* Lock ourselves. */
+        std::scoped_lock lk(m_mutex);
+
+        /* Forget the socket's readiness, and invalidate any readiness the host is reporting concurrently. */
+        if (const auto index = this->Find(id); index >= 0) {
+            m_socket_list[index].m_readiness          = 0;
+            m_socket_list[index].m_readiness_sequence = ++m_readiness_sequence;
+        }
+    }
+
     s32 VirtualSocketCollection::CreateSocket(sf::SharedPointer<tma::ISocket> socket, s32 &error_code) {
         /* Clear the error code. */
         error_code = 0;
@@ -21,6 +21,11 @@ namespace ams::htcs::client {
     struct VirtualSocket;
 
     class VirtualSocketCollection {
+        private:
+            struct ReadinessSnapshotEntry {
+                s32 primitive;
+                u32 sequence;
+            };
         private:
             void *m_buffer;
             size_t m_buffer_size;
@@ -28,6 +33,8 @@ namespace ams::htcs::client {
             s32 m_list_count;
             s32 m_list_size;
             s32 m_next_id;
+            s32 m_local_select_count;
+            u32 m_readiness_sequence;
             os::SdkMutex m_mutex;
         public:
             static size_t GetWorkingMemorySize(int num_sockets);
@@ -53,6 +60,7 @@ namespace ams::htcs::client {
             s32 Connect(s32 id, const htcs::SockAddrHtcs *address, s32 &error_code);
 
             s32 Select(htcs::FdSet *read, htcs::FdSet *write, htcs::FdSet *except, htcs::TimeVal *timeout, s32 &error_code);
+            s32 Poll(htcs::PollFd *fds, s32 count, s32 timeout_ms, s32 &error_code);
         private:
             s32 CreateId();
 
@@ -72,9 +80,16 @@ namespace ams::htcs::client {
 
             sf::SharedPointer<tma::ISocket> DoAccept(sf::SharedPointer<tma::ISocket> socket, s32 id, htcs::SockAddrHtcs *address, s32 &error_code);
 
+            s32 GetPrimitive(s32 id, s32 &error_code);
             s32 GetSockets(s32 * const out_primitives, htcs::FdSet *set, s32 &error_code);
             void SetSockets(htcs::FdSet *set, s32 * const primitives, s32 count);
 
+            s32 SelectImpl(s32 * const read, s32 num_read, s32 * const write, s32 num_write, s32 * const except, s32 num_except, htcs::TimeVal *timeout, s32 &error_code);
+            bool SelectKnownReadySockets(s32 *out, s32 * const read, s32 num_read, s32 * const write, s32 num_write, s32 * const except, s32 num_except);
+            s32 SnapshotReadiness(ReadinessSnapshotEntry *out, s32 max_count);
+            void RecordReadiness(const s32 *primitives, s32 count, u8 readiness, const ReadinessSnapshotEntry *snapshot, s32 snapshot_count);
+            void ClearReadiness(s32 id);
+
             s32 CreateSocket(sf::SharedPointer<tma::ISocket> socket, s32 &error_code);
     };
 
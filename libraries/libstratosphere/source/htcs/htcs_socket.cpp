@@ -387,6 +387,29 @@ namespace ams::htcs {
         return ret;
     }
 
+    s32 Poll(PollFd *fds, s32 count, s32 timeout) {
+        /* Check that we have a manager. */
+        AMS_ASSERT(g_manager != nullptr);
+
+        /* Check that we have a socket collection. */
+        AMS_ASSERT(g_sockets != nullptr);
+
+        /* Check that we have some form of input. */
+        if (fds == nullptr) {
+            SetLastError(static_cast<uintptr_t>(HTCS_EINVAL));
+            return -1;
+        }
+
+        /* Perform the operation. */
+        s32 error_code = 0;
+        const s32 ret = g_sockets->Poll(fds, count, timeout, error_code);
+        if (ret < 0) {
+            SetLastError(static_cast<uintptr_t>(error_code));
+        }
+
+        return ret;
+    }
+
     ssize_t Recv(s32 desc, void *buffer, size_t buffer_size, s32 flags) {
         /* Check that we have a manager. */
         AMS_ASSERT(g_manager != nullptr);
@@ -462,6 +485,79 @@ namespace ams::htcs {
         return false;
     }
 
+    s32 PollSet::Add(s32 desc, s16 events) {
+        /* Check that the socket isn't already registered. */
+        for (auto i = 0; i < m_count; ++i) {
+            if (m_fds[i].fd == desc) {
+                SetLastError(static_cast<uintptr_t>(HTCS_EINVAL));
+                return -1;
+            }
+        }
+
+        /* Check that we have room for the socket. */
+        if (m_count >= SocketCountMax) {
+            SetLastError(static_cast<uintptr_t>(HTCS_ENOBUFS));
+            return -1;
+        }
+
+        /* Register the socket. */
+        m_fds[m_count++] = { .fd = desc, .events = events, .revents = 0 };
+        return 0;
+    }
+
+    s32 PollSet::Modify(s32 desc, s16 events) {
+        /* Update the socket's events. */
+        for (auto i = 0; i < m_count; ++i) {
+            if (m_fds[i].fd == desc) {
+                m_fds[i].events = events;
+                return 0;
+            }
+        }
+
+        SetLastError(static_cast<uintptr_t>(HTCS_EINVAL));
+        return -1;
+    }
+
+    s32 PollSet::Remove(s32 desc) {
+        /* Unregister the socket. */
+        for (auto i = 0; i < m_count; ++i) {
+            if (m_fds[i].fd == desc) {
+                std::memmove(m_fds + i, m_fds + i + 1, (m_count - (i + 1)) * sizeof(m_fds[0]));
+                --m_count;
+                return 0;
+            }
+        }
+
+        SetLastError(static_cast<uintptr_t>(HTCS_EINVAL));
+        return -1;
+    }
+
+    s32 PollSet::Wait(PollFd *out, s32 max_count, s32 timeout) {
+        /* Check that we have somewhere to write our output. */
+        if (out == nullptr || max_count <= 0) {
+            SetLastError(static_cast<uintptr_t>(HTCS_EINVAL));
+            return -1;
+        }
+
+        /* Poll our sockets. */
+        /* NOTE: This is not event-driven; every registered socket is polled on each wait. */
+        /* The set only saves callers from rebuilding their descriptor array between waits. */
+        const s32 ret = Poll(m_fds, m_count, timeout);
+        if (ret <= 0) {
+            return ret;
+        }
+
+        /* Copy out the ready sockets. */
+        s32 count = 0;
+        for (auto i = 0; i < m_count && count < max_count; ++i) {
+            if (m_fds[i].revents != 0) {
+                out[count++] = m_fds[i];
+            }
+        }
+
+        return count;
+    }
+
     namespace client {
 
         sf::SharedPointer<tma::ISocket> socket(s32 &last_error) {
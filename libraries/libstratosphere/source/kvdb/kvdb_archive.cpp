@@ -155,6 +155,57 @@ namespace ams::kvdb {
         R_ABORT_UNLESS(this->Write(value, value_size));
     }
 
+    /* File writer functionality. */
+    Result ArchiveFileWriter::Write(const void *src, size_t size) {
+        /* Make room in the buffer, if we need to. */
+        if (m_buffered_size + size > m_buffer.GetSize()) {
+            R_TRY(this->FlushBuffer());
+        }
+
+        /* Data too large to buffer is written directly. */
+        if (size >= m_buffer.GetSize()) {
+            R_TRY(fs::WriteFile(m_file, m_offset, src, size, fs::WriteOption::None));
+            m_offset += size;
+            return ResultSuccess();
+        }
+
+        std::memcpy(m_buffer.Get() + m_buffered_size, src, size);
+        m_buffered_size += size;
+        return ResultSuccess();
+    }
+
+    Result ArchiveFileWriter::FlushBuffer() {
+        R_SUCCEED_IF(m_buffered_size == 0);
+
+        R_TRY(fs::WriteFile(m_file, m_offset, m_buffer.Get(), m_buffered_size, fs::WriteOption::None));
+        m_offset        += m_buffered_size;
+        m_buffered_size  = 0;
+        return ResultSuccess();
+    }
+
+    Result ArchiveFileWriter::WriteHeader(size_t entry_count) {
+        /* This should only be called at start of write. */
+        AMS_ABORT_UNLESS(m_offset == 0 && m_buffered_size == 0);
+
+        ArchiveHeader header = ArchiveHeader::Make(entry_count);
+        return this->Write(std::addressof(header), sizeof(header));
+    }
+
+    Result ArchiveFileWriter::WriteEntry(const void *key, size_t key_size, const void *value, size_t value_size) {
+        /* This should only be called after writing header. */
+        AMS_ABORT_UNLESS(m_offset != 0 || m_buffered_size != 0);
+
+        ArchiveEntryHeader header = ArchiveEntryHeader::Make(key_size, value_size);
+        R_TRY(this->Write(std::addressof(header), sizeof(header)));
+        R_TRY(this->Write(key, key_size));
+        return this->Write(value, value_size);
+    }
+
+    Result ArchiveFileWriter::Flush() {
+        R_TRY(this->FlushBuffer());
+        return fs::FlushFile(m_file);
+    }
+
     /* Size helper functionality. */
     ArchiveSizeHelper::ArchiveSizeHelper() : m_size(sizeof(ArchiveHeader)) {
         /* ... */
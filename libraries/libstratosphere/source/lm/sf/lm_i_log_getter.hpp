@@ -16,9 +16,10 @@
 #pragma once
 #include <stratosphere.hpp>
 
-#define AMS_LM_I_LOG_GETTER_INTERFACE_INFO(C, H)                                                                                                                                         \
-    AMS_SF_METHOD_INFO(C, H, 0, Result, StartLogging, (),                                                                                           ())                                  \
-    AMS_SF_METHOD_INFO(C, H, 1, Result, StopLogging,  (),                                                                                           ())                                  \
-    AMS_SF_METHOD_INFO(C, H, 2, Result, GetLog,       (const sf::OutAutoSelectBuffer &message, sf::Out<s64> out_size, sf::Out<u32> out_drop_count), (message, out_size, out_drop_count))
+#define AMS_LM_I_LOG_GETTER_INTERFACE_INFO(C, H)                                                                                                                                                                 \
+    AMS_SF_METHOD_INFO(C, H,     0, Result, StartLogging,                     (),                                                                                           ())                                  \
+    AMS_SF_METHOD_INFO(C, H,     1, Result, StopLogging,                      (),                                                                                           ())                                  \
+    AMS_SF_METHOD_INFO(C, H,     2, Result, GetLog,                           (const sf::OutAutoSelectBuffer &message, sf::Out<s64> out_size, sf::Out<u32> out_drop_count), (message, out_size, out_drop_count)) \
+    AMS_SF_METHOD_INFO(C, H, 65000, Result, AtmosphereGetLogBufferStatistics, (sf::Out<lm::LogBufferStatistics> out),                                                       (out))
 
 AMS_SF_DEFINE_INTERFACE(ams::lm, ILogGetter, AMS_LM_I_LOG_GETTER_INTERFACE_INFO)
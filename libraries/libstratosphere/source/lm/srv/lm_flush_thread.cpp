@@ -124,9 +124,18 @@ namespace ams::lm::srv {
 
             /* Do flush loop. */
             do {
-                if (LogBuffer::GetDefaultInstance().Flush()) {
+                /* If the SD card logger has uncommitted data, only wait for new logs until it should be committed. */
+                TimeSpan commit_timeout;
+                const bool has_commit_timeout = SdCardLogger::GetInstance().GetCommitTimeout(std::addressof(commit_timeout));
+
+                if (has_commit_timeout ? LogBuffer::GetDefaultInstance().TimedFlush(commit_timeout) : LogBuffer::GetDefaultInstance().Flush()) {
                     EventLogTransmitter::GetDefaultInstance().PushLogPacketDropCountIfExists();
                 }
+
+                /* Commit the SD card log, if we've waited long enough. */
+                if (has_commit_timeout) {
+                    SdCardLogger::GetInstance().CommitIfTimedOut();
+                }
             } while (WaitForFlush());
 
             /* Clear connection observer. */
@@ -17,6 +17,7 @@
 #include "../lm_service_name.hpp"
 #include "lm_log_service_impl.hpp"
 #include "lm_log_getter.hpp"
+#include "lm_sd_card_logger.hpp"
 
 namespace ams::lm::srv {
 
@@ -114,8 +115,10 @@ namespace ams::lm::srv {
                     g_is_sleeping = false;
                 } else if (prev_state == psc::PmState_MinimumAwake && pm_state == psc::PmState_SleepReady) {
                     g_is_sleeping = true;
+                    SdCardLogger::GetInstance().Flush();
                 } else if (pm_state == psc::PmState_ShutdownReady) {
                     g_is_sleeping = true;
+                    SdCardLogger::GetInstance().Flush();
                 }
 
                 /* Set the previous state. */
@@ -86,15 +86,15 @@ namespace ams::lm::srv {
     }
 
     LogBuffer &LogBuffer::GetDefaultInstance() {
-        AMS_FUNCTION_LOCAL_STATIC_CONSTINIT(u8, s_default_buffers[128_KB * 2]);
+        alignas(BufferAlignment) AMS_FUNCTION_LOCAL_STATIC_CONSTINIT(u8, s_default_buffers[128_KB * 2]);
         AMS_FUNCTION_LOCAL_STATIC_CONSTINIT(LogBuffer, s_default_log_buffer, s_default_buffers, sizeof(s_default_buffers), DefaultFlushFunction);
 
         return s_default_log_buffer;
     }
 
     void LogBuffer::CancelPush() {
-        /* Acquire exclusive access to the push buffer. */
-        std::scoped_lock lk(m_push_buffer_mutex);
+        /* Acquire exclusive access to the wait state. */
+        std::scoped_lock lk(m_wait_mutex);
 
         /* Cancel any pending pushes. */
         if (m_push_ready_wait_count > 0) {
@@ -103,9 +103,43 @@ namespace ams::lm::srv {
         }
     }
 
+    void LogBuffer::GetStatistics(LogBufferStatistics *out) const {
+        *out = {
+            .push_count  = m_push_count.Load(),
+            .drop_count  = m_drop_count.Load(),
+            .stall_count = m_stall_count.Load(),
+        };
+    }
+
+    bool LogBuffer::WaitPushReady(u64 release_position) {
+        /* Acquire exclusive access to the wait state. */
+        std::scoped_lock lk(m_wait_mutex);
+
+        /* Note that we stalled. */
+        ++m_stall_count;
+
+        /* Wait for the flush thread to release space. */
+        /* NOTE: The wait count is published before the release position is re-checked, so that a release can't be missed. */
+        ++m_push_ready_wait_count;
+        while (m_release_position.Load() == release_position && !m_push_canceled) {
+            m_cv_push_ready.Wait(m_wait_mutex);
+        }
+        --m_push_ready_wait_count;
+
+        /* Check if push was canceled. */
+        if (m_push_canceled) {
+            if (m_push_ready_wait_count == 0) {
+                m_push_canceled = false;
+            }
+
+            return false;
+        }
+
+        return true;
+    }
+
     bool LogBuffer::PushImpl(const void *data, size_t size, bool blocking) {
         /* Check pre-conditions. */
-        AMS_ASSERT(size <= m_buffer_size);
         AMS_ASSERT(data != nullptr || size == 0);
 
         /* Check that we have data to push. */
@@ -113,95 +147,171 @@ namespace ams::lm::srv {
             return true;
         }
 
-        /* Wait to be able to push. */
-        u8 *dst;
-        {
-            /* Acquire exclusive access to the push buffer. */
-            std::scoped_lock lk(m_push_buffer_mutex);
+        /* Check that the data can ever fit in the ring. */
+        /* NOTE: A record may need to be padded to the start of the ring, so records are limited to half of the ring. */
+        /* For the default buffer, this limits a single push to just under 64KB, where a whole 128KB half could previously be used. */
+        /* Our lm client sends packets of at most 1KB, so this only affects unusually large messages, which are counted as drops. */
+        const size_t record_size = util::AlignUp(sizeof(RecordHeader) + size, BufferAlignment);
+        if (record_size > m_ring_size / 2) {
+            AMS_ASSERT(record_size <= m_ring_size / 2);
+            ++m_drop_count;
+            return false;
+        }
 
-            /* Wait for enough space to be available. */
-            while (size > m_buffer_size - m_push_buffer->m_stored_size) {
-                /* Only block if we're allowed to. */
-                if (!blocking) {
+        /* Reserve space for our record. */
+        u64 position;
+        size_t padding_size;
+        while (true) {
+            /* Get the current positions. */
+            /* NOTE: The release position must be loaded first, so that it is never ahead of the reserve position. */
+            const u64 release_position = m_release_position.Load();
+            position = m_reserve_position.Load();
+
+            /* If our record would straddle the end of the ring, we need to pad to the start. */
+            const size_t offset = position % m_ring_size;
+            padding_size = (offset + record_size > m_ring_size) ? (m_ring_size - offset) : 0;
+
+            /* Check whether there's space available. */
+            if (position + padding_size + record_size - release_position > m_ring_size) {
+                /* If there's no space, drop the data unless we're allowed to block. */
+                if (!blocking || !this->WaitPushReady(release_position)) {
+                    ++m_drop_count;
                     return false;
                 }
 
-                /* Wait for push to be ready. */
-                {
-                    ++m_push_ready_wait_count;
-                    m_cv_push_ready.Wait(m_push_buffer_mutex);
-                    --m_push_ready_wait_count;
-                }
-
-                /* Check if push was canceled. */
-                if (m_push_canceled) {
-                    if (m_push_ready_wait_count == 0) {
-                        m_push_canceled = false;
-                    }
+                continue;
+            }
 
-                    return false;
-                }
+            /* Try to reserve. */
+            if (m_reserve_position.CompareExchangeWeak(position, position + padding_size + record_size)) {
+                break;
             }
+        }
+
+        /* Write padding, if we need to. */
+        if (padding_size > 0) {
+            RecordHeader *padding = this->GetRecordHeader(position);
+            padding->size = static_cast<u32>(padding_size);
+            util::AtomicRef<u32>(padding->state).Store(RecordState_Padding);
+
+            position += padding_size;
+        }
+
+        /* Write our record. */
+        RecordHeader *record = this->GetRecordHeader(position);
+        record->size = static_cast<u32>(size);
+        std::memcpy(record + 1, data, size);
 
-            /* Set the destination. */
-            dst = m_push_buffer->m_head + m_push_buffer->m_stored_size;
+        /* Commit our record. */
+        util::AtomicRef<u32>(record->state).Store(RecordState_Committed);
+        ++m_push_count;
 
-            /* Advance the push buffer. */
-            m_push_buffer->m_stored_size += size;
-            ++m_push_buffer->m_reference_count;
+        /* If the flush thread is waiting for data, wake it. */
+        if (m_is_waiting_flush_ready.Load()) {
+            std::scoped_lock lk(m_wait_mutex);
+            m_cv_flush_ready.Signal();
         }
 
-        /* Copy the data to the push buffer. */
-        std::memcpy(dst, data, size);
+        return true;
+    }
 
-        /* Close our push buffer reference, and signal that we can flush. */
-        {
-            /* Acquire exclusive access to the push buffer. */
-            std::scoped_lock lk(m_push_buffer_mutex);
+    bool LogBuffer::IsFlushReady() const {
+        /* We're ready to flush if the oldest record has been committed. */
+        const u64 position = m_release_position.Load();
+        return position != m_reserve_position.Load() && util::AtomicRef<u32>(this->GetRecordHeader(position)->state).Load() != RecordState_Free;
+    }
 
-            /* If there are no pending pushes, signal that we can flush. */
-            if ((--m_push_buffer->m_reference_count) == 0) {
-                m_cv_flush_ready.Signal();
+    bool LogBuffer::WaitFlushReady(const TimeSpan *timeout) {
+        /* Acquire exclusive access to the wait state. */
+        std::scoped_lock lk(m_wait_mutex);
+
+        /* Note that we're waiting, so that producers know to wake us. */
+        m_is_waiting_flush_ready = true;
+        ON_SCOPE_EXIT { m_is_waiting_flush_ready = false; };
+
+        /* Wait for a record to be committed. */
+        const auto start_tick = os::GetSystemTick();
+        while (!this->IsFlushReady()) {
+            if (timeout != nullptr) {
+                /* Only wait as long as we're allowed to. */
+                const TimeSpan elapsed = (os::GetSystemTick() - start_tick).ToTimeSpan();
+                if (elapsed >= *timeout) {
+                    return false;
+                }
+
+                m_cv_flush_ready.TimedWait(m_wait_mutex, *timeout - elapsed);
+            } else {
+                m_cv_flush_ready.Wait(m_wait_mutex);
             }
         }
 
         return true;
     }
 
-    bool LogBuffer::FlushImpl(bool blocking) {
-        /* Acquire exclusive access to the flush buffer. */
-        std::scoped_lock lk(m_flush_buffer_mutex);
+    size_t LogBuffer::GatherCommittedRecords() {
+        /* Gather records in order, until we reach one which is not yet committed or does not fit. */
+        const u64 reserve_position = m_reserve_position.Load();
+        u64 position = m_release_position.Load();
+        while (position != reserve_position) {
+            RecordHeader *record = this->GetRecordHeader(position);
+            const u32 state = util::AtomicRef<u32>(record->state).Load();
+            if (state == RecordState_Free) {
+                break;
+            }
 
-        /* If we don't have data to flush, wait for us to have data. */
-        if (m_flush_buffer->m_stored_size == 0) {
-            /* Acquire exclusive access to the push buffer. */
-            std::scoped_lock lk(m_push_buffer_mutex);
+            /* Determine the record's extents. */
+            const size_t record_size = (state == RecordState_Padding) ? record->size : util::AlignUp(sizeof(RecordHeader) + record->size, BufferAlignment);
 
-            /* Wait for there to be pushed data. */
-            while (m_push_buffer->m_stored_size == 0 || m_push_buffer->m_reference_count != 0) {
-                /* Only block if we're allowed to. */
-                if (!blocking) {
-                    return false;
+            /* Copy the record's data, if it has any. */
+            if (state == RecordState_Committed) {
+                if (m_flush_stored_size + record->size > m_flush_buffer_size) {
+                    break;
                 }
 
-                /* Wait for us to be ready to flush. */
-                m_cv_flush_ready.Wait(m_push_buffer_mutex);
+                std::memcpy(m_flush_buffer + m_flush_stored_size, record + 1, record->size);
+                m_flush_stored_size += record->size;
             }
 
-            /* Swap the push buffer and the flush buffer pointers. */
-            std::swap(m_push_buffer, m_flush_buffer);
+            /* Free the record, so that its space may be reserved again. */
+            /* NOTE: Later records may place their headers anywhere in this space, so all of it must read as free. */
+            std::memset(record, 0, record_size);
+            position += record_size;
+        }
 
-            /* Signal that we can push. */
-            m_cv_push_ready.Broadcast();
+        /* If we released any space, publish it and wake any waiting producers. */
+        if (position != m_release_position.Load()) {
+            m_release_position = position;
+
+            if (m_push_ready_wait_count.Load() > 0) {
+                std::scoped_lock lk(m_wait_mutex);
+                m_cv_push_ready.Broadcast();
+            }
+        }
+
+        return m_flush_stored_size;
+    }
+
+    bool LogBuffer::FlushImpl(bool blocking, const TimeSpan *timeout) {
+        /* Acquire exclusive access to the flush buffer. */
+        std::scoped_lock lk(m_flush_buffer_mutex);
+
+        /* If we don't have data to flush, gather it, waiting for some to be pushed if we're allowed to. */
+        if (m_flush_stored_size == 0 && this->GatherCommittedRecords() == 0) {
+            /* Only block if we're allowed to. */
+            if (!blocking || !this->WaitFlushReady(timeout)) {
+                return false;
+            }
+
+            this->GatherCommittedRecords();
         }
 
         /* Flush any data. */
-        if (!m_flush_function(m_flush_buffer->m_head, m_flush_buffer->m_stored_size)) {
+        if (!m_flush_function(m_flush_buffer, m_flush_stored_size)) {
             return false;
         }
 
         /* Reset the flush buffer. */
-        m_flush_buffer->m_stored_size = 0;
+        m_flush_stored_size = 0;
 
         return true;
     }
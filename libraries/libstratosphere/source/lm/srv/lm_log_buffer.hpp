@@ -21,39 +21,55 @@ namespace ams::lm::srv {
     class LogBuffer {
         NON_COPYABLE(LogBuffer);
         NON_MOVEABLE(LogBuffer);
+        public:
+            static constexpr size_t BufferAlignment = 8;
         private:
-            struct BufferInfo {
-                u8 *m_head;
-                size_t m_stored_size;
-                size_t m_reference_count;
+            /* NOTE: Pushed data is stored as records in a ring, which producers reserve and fill without taking any lock. */
+            /* The flush thread gathers committed records (in reservation order) into the flush buffer before flushing them. */
+            /* The buffer must be zero-initialized, so that the ring initially consists only of free space. */
+            struct RecordHeader {
+                u32 state;
+                u32 size;
+            };
+            static_assert(sizeof(RecordHeader) == BufferAlignment);
+
+            enum RecordState : u32 {
+                RecordState_Free      = 0,
+                RecordState_Committed = 1,
+                RecordState_Padding   = 2,
             };
         public:
             using FlushFunction = bool (*)(const u8 *data, size_t size);
         private:
-            BufferInfo m_buffers[2];
-            BufferInfo *m_push_buffer;
-            BufferInfo *m_flush_buffer;
-            size_t m_buffer_size;
+            u8 *m_ring;
+            size_t m_ring_size;
+            u8 *m_flush_buffer;
+            size_t m_flush_buffer_size;
+            size_t m_flush_stored_size;
             FlushFunction m_flush_function;
-            os::SdkMutex m_push_buffer_mutex;
+            util::Atomic<u64> m_reserve_position;
+            util::Atomic<u64> m_release_position;
             os::SdkMutex m_flush_buffer_mutex;
+            os::SdkMutex m_wait_mutex;
             os::SdkConditionVariable m_cv_push_ready;
             os::SdkConditionVariable m_cv_flush_ready;
+            util::Atomic<u32> m_push_ready_wait_count;
+            util::Atomic<bool> m_is_waiting_flush_ready;
             bool m_push_canceled;
-            size_t m_push_ready_wait_count;
+            util::Atomic<u64> m_push_count;
+            util::Atomic<u64> m_drop_count;
+            util::Atomic<u64> m_stall_count;
         public:
             constexpr explicit LogBuffer(void *buffer, size_t buffer_size, FlushFunction f)
-                : m_buffers{}, m_push_buffer(m_buffers + 0), m_flush_buffer(m_buffers + 1),
-                  m_buffer_size(buffer_size / 2), m_flush_function(f), m_push_buffer_mutex{},
-                  m_flush_buffer_mutex{}, m_cv_push_ready{}, m_cv_flush_ready{},
-                  m_push_canceled(false), m_push_ready_wait_count(0)
+                : m_ring(static_cast<u8 *>(buffer)), m_ring_size(util::AlignDown(buffer_size / 2, BufferAlignment)),
+                  m_flush_buffer(static_cast<u8 *>(buffer) + util::AlignDown(buffer_size / 2, BufferAlignment)), m_flush_buffer_size(buffer_size - util::AlignDown(buffer_size / 2, BufferAlignment)),
+                  m_flush_stored_size(0), m_flush_function(f), m_reserve_position(0), m_release_position(0), m_flush_buffer_mutex{}, m_wait_mutex{},
+                  m_cv_push_ready{}, m_cv_flush_ready{}, m_push_ready_wait_count(0), m_is_waiting_flush_ready(false), m_push_canceled(false),
+                  m_push_count(0), m_drop_count(0), m_stall_count(0)
             {
                 AMS_ASSERT(buffer != nullptr);
                 AMS_ASSERT(buffer_size > 0);
                 AMS_ASSERT(f != nullptr);
-
-                m_buffers[0].m_head = static_cast<u8 *>(buffer);
-                m_buffers[1].m_head = static_cast<u8 *>(buffer) + (buffer_size / 2);
             }
 
             static LogBuffer &GetDefaultInstance();
@@ -63,11 +79,22 @@ namespace ams::lm::srv {
 
             void CancelPush();
 
-            bool Flush() { return this->FlushImpl(true); }
-            bool TryFlush() { return this->FlushImpl(false); }
+            bool Flush() { return this->FlushImpl(true, nullptr); }
+            bool TryFlush() { return this->FlushImpl(false, nullptr); }
+            bool TimedFlush(TimeSpan timeout) { return this->FlushImpl(true, std::addressof(timeout)); }
+
+            void GetStatistics(LogBufferStatistics *out) const;
         private:
             bool PushImpl(const void *data, size_t size, bool blocking);
-            bool FlushImpl(bool blocking);
+            bool FlushImpl(bool blocking, const TimeSpan *timeout);
+
+            RecordHeader *GetRecordHeader(u64 position) const { return reinterpret_cast<RecordHeader *>(m_ring + (position % m_ring_size)); }
+
+            bool WaitPushReady(u64 release_position);
+            bool WaitFlushReady(const TimeSpan *timeout);
+
+            bool IsFlushReady() const;
+            size_t GatherCommittedRecords();
     };
 
 }
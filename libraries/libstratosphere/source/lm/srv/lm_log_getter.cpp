@@ -16,6 +16,7 @@
 #include <stratosphere.hpp>
 #include "lm_log_getter.hpp"
 #include "lm_log_getter_impl.hpp"
+#include "lm_log_buffer.hpp"
 
 namespace ams::lm::srv {
 
@@ -43,4 +44,9 @@ namespace ams::lm::srv {
         return ResultSuccess();
     }
 
+    Result LogGetter::AtmosphereGetLogBufferStatistics(sf::Out<lm::LogBufferStatistics> out) {
+        LogBuffer::GetDefaultInstance().GetStatistics(out.GetPointer());
+        return ResultSuccess();
+    }
+
 }
@@ -24,6 +24,7 @@ namespace ams::lm::srv {
             Result StartLogging();
             Result StopLogging();
             Result GetLog(const sf::OutAutoSelectBuffer &message, sf::Out<s64> out_size, sf::Out<u32> out_drop_count);
+            Result AtmosphereGetLogBufferStatistics(sf::Out<lm::LogBufferStatistics> out);
     };
     static_assert(lm::IsILogGetter<LogGetter>);
 
@@ -16,6 +16,7 @@
 #include <stratosphere.hpp>
 #include "lm_sd_card_logger.hpp"
 #include "lm_time_util.hpp"
+#include "lm_log_packet_parser.hpp"
 
 namespace ams::lm::srv {
 
@@ -27,6 +28,12 @@ namespace ams::lm::srv {
         constexpr const char SettingName[]               = "lm";
         constexpr const char SettingKeyLoggingEnabled[]  = "enable_sd_card_logging";
         constexpr const char SettingKeyOutputDirectory[] = "sd_card_log_output_directory";
+        constexpr const char SettingKeyLogFileSizeMax[]  = "sd_card_log_file_size_max";
+
+        /* NOTE: Nintendo opens, writes with flush, and closes the log file for every write. */
+        /* We instead keep the log file open, and only commit once enough data/time has accumulated. */
+        constexpr inline size_t CommitThresholdSize = 64_KB;
+        constexpr inline TimeSpan CommitInterval    = TimeSpan::FromSeconds(1);
 
         constexpr inline size_t LogFileHeaderSize = 8;
         constexpr inline u32 LogFileHeaderMagic   = util::ReverseFourCC<'p','h','p','h'>::Code;
@@ -49,6 +56,8 @@ namespace ams::lm::srv {
         constinit std::unique_ptr<fs::IEventNotifier> g_sd_card_detection_event_notifier;
         os::SystemEvent g_sd_card_detection_event;
 
+        constinit u32 g_log_file_size_max = 0;
+
         bool GetSdCardLoggingEnabledImpl() {
             bool enabled;
             const auto size = settings::fwdbg::GetSettingsItemValue(std::addressof(enabled), sizeof(enabled), SettingName, SettingKeyLoggingEnabled);
@@ -73,6 +82,15 @@ namespace ams::lm::srv {
             return g_sd_card_logging_enabled;
         }
 
+        u32 GetSdCardLogFileSizeMax() {
+            u32 size_max;
+            if (settings::fwdbg::GetSettingsItemValue(std::addressof(size_max), sizeof(size_max), SettingName, SettingKeyLogFileSizeMax) != sizeof(size_max)) {
+                return 0;
+            }
+
+            return size_max;
+        }
+
         void EnsureSdCardDetectionEventInitialized() {
             if (AMS_UNLIKELY(!g_sd_card_detection_event_initialized)) {
                 std::scoped_lock lk(g_sd_card_detection_event_mutex);
@@ -185,12 +203,7 @@ namespace ams::lm::srv {
             return false;
         }
 
-        Result WriteLogFileHeaderImpl(const char *path) {
-            /* Open the log file. */
-            fs::FileHandle file;
-            R_TRY(fs::OpenFile(std::addressof(file), path, fs::OpenMode_Write | fs::OpenMode_AllowAppend));
-            ON_SCOPE_EXIT { fs::CloseFile(file); };
-
+        Result WriteLogFileHeader(fs::FileHandle file) {
             /* Write the log file header. */
             const LogFileHeader header = {
                 .magic   = LogFileHeaderMagic,
@@ -202,29 +215,20 @@ namespace ams::lm::srv {
             return ResultSuccess();
         }
 
-        bool WriteLogFileHeader(const char *path) {
-            return R_SUCCEEDED(WriteLogFileHeaderImpl(path));
-        }
-
-        Result WriteLogFileBodyImpl(const char *path, s64 offset, const u8 *data, size_t size) {
-            /* Open the log file. */
-            fs::FileHandle file;
-            R_TRY(fs::OpenFile(std::addressof(file), path, fs::OpenMode_Write | fs::OpenMode_AllowAppend));
-            ON_SCOPE_EXIT { fs::CloseFile(file); };
-
-            /* Write the data. */
-            R_TRY(fs::WriteFile(file, offset, data, size, fs::WriteOption::Flush));
-
-            return ResultSuccess();
-        }
-
-        bool WriteLogFileBody(const char *path, s64 offset, const u8 *data, size_t size) {
-            return R_SUCCEEDED(WriteLogFileBodyImpl(path, offset, data, size));
+        bool ContainsFatalLog(const u8 *data, size_t size) {
+            /* NOTE: The parser stops (and returns false) as soon as we find a fatal log. */
+            return !LogPacketParser::ParsePacket(data, size, [](const impl::LogPacketHeader &header, const void *payload, size_t payload_size, void *arg) -> bool {
+                AMS_UNUSED(payload, payload_size, arg);
+                return header.GetSeverity() != diag::LogSeverity_Fatal;
+            }, nullptr);
         }
 
     }
 
-    SdCardLogger::SdCardLogger() : m_logging_observer_mutex(), m_is_enabled(false), m_is_sd_card_mounted(false), m_is_sd_card_status_unknown(false), m_log_file_offset(0), m_logging_observer(nullptr) {
+    SdCardLogger::SdCardLogger()
+        : m_logging_observer_mutex(), m_log_file_mutex(), m_is_enabled(false), m_is_sd_card_mounted(false), m_is_sd_card_status_unknown(false), m_is_log_file_opened(false),
+          m_log_file(), m_log_file_offset(0), m_uncommitted_size(0), m_last_commit_tick(), m_logging_observer(nullptr)
+    {
         /* ... */
     }
 
@@ -299,13 +303,38 @@ namespace ams::lm::srv {
             return false;
         }
 
+        /* Get the size at which we should rotate to a new log file. */
+        g_log_file_size_max = GetSdCardLogFileSizeMax();
+
+        /* Create a log file for us to write to. */
+        return this->CreateLogFile(output_dir);
+    }
+
+    void SdCardLogger::Invalidate() {
+        /* Close our log file, discarding anything we failed to commit. */
+        this->CloseLogFile();
+
+        /* Unmount the SD card. */
+        if (m_is_sd_card_mounted) {
+            fs::Unmount(SdCardMountName);
+            m_is_sd_card_mounted        = false;
+            m_is_sd_card_status_unknown = true;
+        }
+    }
+
+    bool SdCardLogger::CreateLogFile(const char *dir) {
         /* Ensure that a log file exists for us to write to. */
-        if (!GenerateLogFile(m_log_file_path, sizeof(m_log_file_path), output_dir)) {
+        if (!GenerateLogFile(m_log_file_path, sizeof(m_log_file_path), dir)) {
+            return false;
+        }
+
+        /* Open the log file. */
+        if (!this->OpenLogFile()) {
             return false;
         }
 
         /* Write the log file header. */
-        if (!WriteLogFileHeader(m_log_file_path)) {
+        if (R_FAILED(WriteLogFileHeader(m_log_file))) {
             return false;
         }
 
@@ -315,9 +344,91 @@ namespace ams::lm::srv {
         return true;
     }
 
+    bool SdCardLogger::RotateLogFile(size_t size) {
+        /* If the write fits in the current log file, we don't need to rotate. */
+        /* NOTE: We never rotate away from an empty log file, so that oversized writes still succeed. */
+        if (g_log_file_size_max == 0 || m_log_file_offset == static_cast<s64>(LogFileHeaderSize) || m_log_file_offset + size <= g_log_file_size_max) {
+            return true;
+        }
+
+        /* Commit and close the current log file. */
+        if (!this->CommitLogFile()) {
+            return false;
+        }
+        this->CloseLogFile();
+
+        /* Get the output directory. */
+        char output_dir[0x80];
+        if (!GetSdCardLogOutputDirectory(output_dir, sizeof(output_dir))) {
+            return false;
+        }
+
+        /* Create a new log file. */
+        return this->CreateLogFile(output_dir);
+    }
+
+    bool SdCardLogger::OpenLogFile() {
+        /* If the log file is already open, nothing to do. */
+        if (m_is_log_file_opened) {
+            return true;
+        }
+
+        /* Open the log file. */
+        if (R_FAILED(fs::OpenFile(std::addressof(m_log_file), m_log_file_path, fs::OpenMode_Write | fs::OpenMode_AllowAppend))) {
+            return false;
+        }
+
+        m_is_log_file_opened = true;
+        m_uncommitted_size   = 0;
+        m_last_commit_tick   = os::GetSystemTick();
+
+        return true;
+    }
+
+    void SdCardLogger::CloseLogFile() {
+        /* If the log file isn't open, nothing to do. */
+        if (!m_is_log_file_opened) {
+            return;
+        }
+
+        /* Flush the file, if we need to. */
+        /* NOTE: fs aborts if a file with unflushed writes is closed; a failed flush leaves the file safe to close. */
+        if (m_uncommitted_size > 0) {
+            static_cast<void>(fs::FlushFile(m_log_file));
+        }
+
+        /* Close the file. */
+        fs::CloseFile(m_log_file);
+
+        m_is_log_file_opened = false;
+        m_uncommitted_size   = 0;
+    }
+
+    bool SdCardLogger::CommitLogFile() {
+        /* If we have nothing to commit, we're done. */
+        if (m_uncommitted_size == 0) {
+            return true;
+        }
+
+        /* Flush the log file. */
+        if (R_FAILED(fs::FlushFile(m_log_file))) {
+            return false;
+        }
+
+        m_uncommitted_size = 0;
+        m_last_commit_tick = os::GetSystemTick();
+
+        return true;
+    }
+
     void SdCardLogger::Finalize() {
+        std::scoped_lock lk(m_log_file_mutex);
+
         this->SetEnabled(false);
         if (m_is_sd_card_mounted) {
+            static_cast<void>(this->CommitLogFile());
+            this->CloseLogFile();
+
             fs::Unmount(SdCardMountName);
             m_is_sd_card_mounted = false;
         }
@@ -329,13 +440,14 @@ namespace ams::lm::srv {
             return false;
         }
 
+        /* Acquire exclusive access to our log file. */
+        std::scoped_lock lk(m_log_file_mutex);
+
         /* Ensure we keep our pre and post-conditions in check. */
         bool success = false;
         ON_SCOPE_EXIT {
-            if (!success && m_is_sd_card_mounted) {
-                fs::Unmount(SdCardMountName);
-                m_is_sd_card_mounted        = false;
-                m_is_sd_card_status_unknown = true;
+            if (!success) {
+                this->Invalidate();
             }
             this->SetEnabled(success);
         };
@@ -345,17 +457,76 @@ namespace ams::lm::srv {
             return false;
         }
 
+        /* Rotate to a new log file, if the current one is full. */
+        if (!this->RotateLogFile(size)) {
+            return false;
+        }
+
+        /* Ensure our log file is open. */
+        if (!this->OpenLogFile()) {
+            return false;
+        }
+
         /* Try to write the log file. */
-        if (!WriteLogFileBody(m_log_file_path, m_log_file_offset, data, size)) {
+        if (R_FAILED(fs::WriteFile(m_log_file, m_log_file_offset, data, size, fs::WriteOption::None))) {
             return false;
         }
 
         /* Advance. */
-        m_log_file_offset += size;
+        m_log_file_offset  += size;
+        m_uncommitted_size += size;
+
+        /* Commit, if we've accumulated enough data or time, or if a fatal log must be made durable immediately. */
+        if (m_uncommitted_size >= CommitThresholdSize || (os::GetSystemTick() - m_last_commit_tick).ToTimeSpan() >= CommitInterval || ContainsFatalLog(data, size)) {
+            if (!this->CommitLogFile()) {
+                return false;
+            }
+        }
 
         /* We succeeded. */
         success = true;
         return true;
     }
 
+    bool SdCardLogger::GetCommitTimeout(TimeSpan *out) {
+        std::scoped_lock lk(m_log_file_mutex);
+
+        /* If we have nothing to commit, there's no timeout. */
+        if (!m_is_log_file_opened || m_uncommitted_size == 0) {
+            return false;
+        }
+
+        /* Determine how long until we should commit. */
+        const TimeSpan elapsed = (os::GetSystemTick() - m_last_commit_tick).ToTimeSpan();
+        *out = elapsed < CommitInterval ? CommitInterval - elapsed : TimeSpan(0);
+        return true;
+    }
+
+    void SdCardLogger::CommitIfTimedOut() {
+        std::scoped_lock lk(m_log_file_mutex);
+
+        /* If we have nothing to commit, or it isn't time to commit yet, we're done. */
+        if (!m_is_log_file_opened || m_uncommitted_size == 0 || (os::GetSystemTick() - m_last_commit_tick).ToTimeSpan() < CommitInterval) {
+            return;
+        }
+
+        /* Commit, disabling logging on failure. */
+        if (!this->CommitLogFile()) {
+            this->Invalidate();
+            this->SetEnabled(false);
+        }
+    }
+
+    void SdCardLogger::Flush() {
+        std::scoped_lock lk(m_log_file_mutex);
+
+        /* Commit and close our log file; it will be re-opened by the next write. */
+        if (!this->CommitLogFile()) {
+            this->Invalidate();
+            this->SetEnabled(false);
+        } else {
+            this->CloseLogFile();
+        }
+    }
+
 }
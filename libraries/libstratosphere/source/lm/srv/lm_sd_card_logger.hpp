@@ -24,11 +24,16 @@ namespace ams::lm::srv {
             using LoggingObserver = void (*)(bool available);
         private:
             os::SdkMutex m_logging_observer_mutex;
+            os::SdkMutex m_log_file_mutex;
             bool m_is_enabled;
             bool m_is_sd_card_mounted;
             bool m_is_sd_card_status_unknown;
+            bool m_is_log_file_opened;
             char m_log_file_path[0x80];
+            fs::FileHandle m_log_file;
             s64 m_log_file_offset;
+            size_t m_uncommitted_size;
+            os::Tick m_last_commit_tick;
             LoggingObserver m_logging_observer;
         public:
             void Finalize();
@@ -36,11 +41,23 @@ namespace ams::lm::srv {
             void SetLoggingObserver(LoggingObserver observer);
 
             bool Write(const u8 *data, size_t size);
+
+            bool GetCommitTimeout(TimeSpan *out);
+            void CommitIfTimedOut();
+
+            void Flush();
         private:
             bool GetEnabled() const;
             void SetEnabled(bool enabled);
 
             bool Initialize();
+            void Invalidate();
+
+            bool CreateLogFile(const char *dir);
+            bool RotateLogFile(size_t size);
+            bool OpenLogFile();
+            void CloseLogFile();
+            bool CommitLogFile();
     };
 
 }
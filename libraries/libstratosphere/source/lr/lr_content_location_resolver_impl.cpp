@@ -28,10 +28,68 @@ namespace ams::lr {
         m_content_storage.GetPath(reinterpret_cast<ncm::Path *>(out), content_id);
     }
 
+    bool ContentLocationResolverImpl::UpdateResolutionCacheGeneration(u32 *out_generation) {
+        /* If we can't observe changes to the content meta database, we can't cache anything. */
+        u32 generation;
+        if (!ncm::GetContentMetaDatabaseGeneration(std::addressof(generation))) {
+            return false;
+        }
+
+        /* If the content meta database may have changed, discard everything we've cached. */
+        if (generation != m_resolution_cache_generation) {
+            this->InvalidateResolutionCache();
+            m_resolution_cache_generation = generation;
+        }
+
+        *out_generation = generation;
+        return true;
+    }
+
+    bool ContentLocationResolverImpl::FindResolutionCache(Path *out, u64 id, ResolutionType type) {
+        for (const auto &entry : m_resolution_cache) {
+            if (entry.is_valid && entry.id == id && entry.type == type) {
+                *out = entry.path;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void ContentLocationResolverImpl::StoreResolutionCache(u32 generation, u64 id, ResolutionType type, const Path &path) {
+        /* If the content meta database changed since the generation was snapshotted, the path may be stale. */
+        u32 cur_generation;
+        if (!this->UpdateResolutionCacheGeneration(std::addressof(cur_generation)) || cur_generation != generation) {
+            return;
+        }
+
+        /* Replace the oldest entry. */
+        auto &entry = m_resolution_cache[m_resolution_cache_next];
+        entry.id       = id;
+        entry.type     = type;
+        entry.is_valid = true;
+        entry.path     = path;
+
+        m_resolution_cache_next = (m_resolution_cache_next + 1) % ResolutionCacheEntryCount;
+    }
+
+    void ContentLocationResolverImpl::InvalidateResolutionCache() {
+        for (auto &entry : m_resolution_cache) {
+            entry.is_valid = false;
+        }
+        m_resolution_cache_next = 0;
+    }
+
     Result ContentLocationResolverImpl::ResolveProgramPath(sf::Out<Path> out, ncm::ProgramId id) {
         /* Use a redirection if present. */
         R_SUCCEED_IF(m_program_redirector.FindRedirection(out.GetPointer(), id));
 
+        /* Use a previous resolution if the content meta database hasn't changed since. */
+        /* NOTE: The generation is snapshotted before the database is queried, so that a concurrent change can't be cached. */
+        u32 generation;
+        const bool cacheable = this->UpdateResolutionCacheGeneration(std::addressof(generation));
+        R_SUCCEED_IF(cacheable && this->FindResolutionCache(out.GetPointer(), id.value, ResolutionType_Program));
+
         /* Find the latest program content for the program id. */
         ncm::ContentId program_content_id;
         R_TRY_CATCH(m_content_meta_database.GetLatestProgram(std::addressof(program_content_id), id)) {
@@ -40,6 +98,9 @@ namespace ams::lr {
 
         /* Obtain the content path. */
         this->GetContentStoragePath(out.GetPointer(), program_content_id);
+        if (cacheable) {
+            this->StoreResolutionCache(generation, id.value, ResolutionType_Program, *out.GetPointer());
+        }
 
         return ResultSuccess();
     }
@@ -60,12 +121,21 @@ namespace ams::lr {
     }
 
     Result ContentLocationResolverImpl::ResolveDataPath(sf::Out<Path> out, ncm::DataId id) {
+        /* Use a previous resolution if the content meta database hasn't changed since. */
+        /* NOTE: The generation is snapshotted before the database is queried, so that a concurrent change can't be cached. */
+        u32 generation;
+        const bool cacheable = this->UpdateResolutionCacheGeneration(std::addressof(generation));
+        R_SUCCEED_IF(cacheable && this->FindResolutionCache(out.GetPointer(), id.value, ResolutionType_Data));
+
         /* Find the latest data content for the program id. */
         ncm::ContentId data_content_id;
         R_TRY(m_content_meta_database.GetLatestData(std::addressof(data_content_id), id));
 
         /* Obtain the content path. */
         this->GetContentStoragePath(out.GetPointer(), data_content_id);
+        if (cacheable) {
+            this->StoreResolutionCache(generation, id.value, ResolutionType_Data, *out.GetPointer());
+        }
 
         return ResultSuccess();
     }
@@ -116,6 +186,9 @@ namespace ams::lr {
         m_content_meta_database = std::move(meta_db);
         m_content_storage       = std::move(storage);
 
+        /* Previous resolutions were made against the old objects. */
+        this->InvalidateResolutionCache();
+
         /* Remove any existing redirections. */
         this->ClearRedirections();
 
@@ -20,19 +20,43 @@
 namespace ams::lr {
 
     class ContentLocationResolverImpl : public LocationResolverImplBase {
+        private:
+            enum ResolutionType : u8 {
+                ResolutionType_Program,
+                ResolutionType_Data,
+            };
+
+            struct ResolutionCacheEntry {
+                u64 id;
+                ResolutionType type;
+                bool is_valid;
+                Path path;
+            };
+
+            static constexpr size_t ResolutionCacheEntryCount = 8;
         private:
             ncm::StorageId m_storage_id;
 
             /* Objects for this storage type. */
             ncm::ContentMetaDatabase m_content_meta_database;
             ncm::ContentStorage m_content_storage;
+
+            /* Cache of recent resolutions, valid for a single content meta database generation. */
+            ResolutionCacheEntry m_resolution_cache[ResolutionCacheEntryCount];
+            size_t m_resolution_cache_next;
+            u32 m_resolution_cache_generation;
         public:
-            ContentLocationResolverImpl(ncm::StorageId storage_id) : m_storage_id(storage_id) { /* ... */ }
+            ContentLocationResolverImpl(ncm::StorageId storage_id) : m_storage_id(storage_id), m_resolution_cache(), m_resolution_cache_next(0), m_resolution_cache_generation(0) { /* ... */ }
 
             ~ContentLocationResolverImpl();
         private:
             /* Helper functions. */
             void GetContentStoragePath(Path *out, ncm::ContentId content_id);
+
+            bool UpdateResolutionCacheGeneration(u32 *out_generation);
+            bool FindResolutionCache(Path *out, u64 id, ResolutionType type);
+            void StoreResolutionCache(u32 generation, u64 id, ResolutionType type, const Path &path);
+            void InvalidateResolutionCache();
         public:
             /* Actual commands. */
             Result ResolveProgramPath(sf::Out<Path> out, ncm::ProgramId id);
@@ -26,9 +26,10 @@ namespace ams::lr {
             ncm::ProgramId m_owner_id;
             Path m_path;
             u32 m_flags;
+            Redirection *m_hash_next;
         public:
             Redirection(ncm::ProgramId program_id, ncm::ProgramId owner_id, const Path &path, u32 flags) :
-                m_program_id(program_id), m_owner_id(owner_id), m_path(path), m_flags(flags) { /* ... */ }
+                m_program_id(program_id), m_owner_id(owner_id), m_path(path), m_flags(flags), m_hash_next(nullptr) { /* ... */ }
 
             ncm::ProgramId GetProgramId() const {
                 return m_program_id;
@@ -49,15 +50,50 @@ namespace ams::lr {
             void SetFlags(u32 flags) {
                 m_flags = flags;
             }
+
+            Redirection *GetHashNext() const {
+                return m_hash_next;
+            }
+
+            void SetHashNext(Redirection *next) {
+                m_hash_next = next;
+            }
     };
 
+    LocationRedirector::Redirection *LocationRedirector::FindRedirectionImpl(ncm::ProgramId program_id) const {
+        /* Walk the bucket for the program id. */
+        for (auto *redirection = m_buckets[GetBucketIndex(program_id)]; redirection != nullptr; redirection = redirection->GetHashNext()) {
+            if (redirection->GetProgramId() == program_id) {
+                return redirection;
+            }
+        }
+        return nullptr;
+    }
+
+    void LocationRedirector::EraseRedirectionImpl(Redirection *redirection) {
+        /* Unlink the redirection from its bucket. */
+        auto &bucket = m_buckets[GetBucketIndex(redirection->GetProgramId())];
+        if (bucket == redirection) {
+            bucket = redirection->GetHashNext();
+        } else {
+            for (auto *prev = bucket; prev != nullptr; prev = prev->GetHashNext()) {
+                if (prev->GetHashNext() == redirection) {
+                    prev->SetHashNext(redirection->GetHashNext());
+                    break;
+                }
+            }
+        }
+
+        /* Remove the redirection from the list. */
+        m_redirection_list.erase(m_redirection_list.iterator_to(*redirection));
+        delete redirection;
+    }
+
     bool LocationRedirector::FindRedirection(Path *out, ncm::ProgramId program_id) const {
         /* Obtain the path of a matching redirection. */
-        for (const auto &redirection : m_redirection_list) {
-            if (redirection.GetProgramId() == program_id) {
-                redirection.GetPath(out);
-                return true;
-            }
+        if (const auto *redirection = this->FindRedirectionImpl(program_id); redirection != nullptr) {
+            redirection->GetPath(out);
+            return true;
         }
         return false;
     }
@@ -71,30 +107,26 @@ namespace ams::lr {
         this->EraseRedirection(program_id);
 
         /* Insert a new redirection into the list. */
-        m_redirection_list.push_back(*(new Redirection(program_id, owner_id, path, flags)));
+        auto *redirection = new Redirection(program_id, owner_id, path, flags);
+        m_redirection_list.push_back(*redirection);
+
+        /* Link the redirection into its bucket. */
+        auto &bucket = m_buckets[GetBucketIndex(program_id)];
+        redirection->SetHashNext(bucket);
+        bucket = redirection;
     }
 
     void LocationRedirector::SetRedirectionFlags(ncm::ProgramId program_id, u32 flags) {
         /* Set the flags of a redirection with a matching program id. */
-        for (auto &redirection : m_redirection_list) {
-            if (redirection.GetProgramId() == program_id) {
-                redirection.SetFlags(flags);
-                break;
-            }
+        if (auto *redirection = this->FindRedirectionImpl(program_id); redirection != nullptr) {
+            redirection->SetFlags(flags);
         }
     }
 
     void LocationRedirector::EraseRedirection(ncm::ProgramId program_id) {
         /* Remove any redirections with a matching program id. */
-        for (auto it = m_redirection_list.begin(); it != m_redirection_list.end(); /* ... */) {
-            if (it->GetProgramId() == program_id) {
-                auto *redirection = std::addressof(*it);
-                it = m_redirection_list.erase(it);
-                delete redirection;
-                break;
-            } else {
-                ++it;
-            }
+        if (auto *redirection = this->FindRedirectionImpl(program_id); redirection != nullptr) {
+            this->EraseRedirectionImpl(redirection);
         }
     }
 
@@ -103,8 +135,8 @@ namespace ams::lr {
         for (auto it = m_redirection_list.begin(); it != m_redirection_list.end(); /* ... */) {
             if ((it->GetFlags() & flags) == flags) {
                 auto *redirection = std::addressof(*it);
-                it = m_redirection_list.erase(it);
-                delete redirection;
+                ++it;
+                this->EraseRedirectionImpl(redirection);
             } else {
                 ++it;
             }
@@ -121,8 +153,8 @@ namespace ams::lr {
 
             /* Remove the redirection. */
             auto *redirection = std::addressof(*it);
-            it = m_redirection_list.erase(it);
-            delete redirection;
+            ++it;
+            this->EraseRedirectionImpl(redirection);
         }
     }
 
@@ -31,10 +31,13 @@ namespace ams::lr {
             class Redirection;
         private:
             using RedirectionList = ams::util::IntrusiveListBaseTraits<Redirection>::ListType;
+
+            static constexpr size_t BucketCount = 0x20;
         private:
             RedirectionList m_redirection_list;
+            Redirection *m_buckets[BucketCount];
         public:
-            LocationRedirector() : m_redirection_list() { /* ... */ }
+            LocationRedirector() : m_redirection_list(), m_buckets() { /* ... */ }
             ~LocationRedirector() { this->ClearRedirections(); }
 
             /* API. */
@@ -46,6 +49,15 @@ namespace ams::lr {
             void ClearRedirections(u32 flags = RedirectionFlags_None);
             void ClearRedirectionsExcludingOwners(const ncm::ProgramId *excluding_ids, size_t num_ids);
         private:
+            Redirection *FindRedirectionImpl(ncm::ProgramId program_id) const;
+            void EraseRedirectionImpl(Redirection *redirection);
+
+            static constexpr size_t GetBucketIndex(ncm::ProgramId program_id) {
+                /* NOTE: Related programs differ only in their low bits, so fold the high bits in as well. */
+                const u64 value = program_id.value;
+                return static_cast<size_t>(value ^ (value >> 16) ^ (value >> 32)) % BucketCount;
+            }
+
             inline bool IsExcluded(const ncm::ProgramId id, const ncm::ProgramId *excluding_ids, size_t num_ids) const {
                 for (size_t i = 0; i < num_ids; i++) {
                     if (id == excluding_ids[i]) {
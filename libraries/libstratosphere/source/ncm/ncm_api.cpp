@@ -15,6 +15,7 @@
  */
 #include <stratosphere.hpp>
 #include "ncm_remote_content_manager_impl.hpp"
+#include "ncm_content_meta_database_generation.hpp"
 
 namespace ams::ncm {
 
@@ -24,12 +25,15 @@ namespace ams::ncm {
 
         sf::UnmanagedServiceObject<IContentManager, RemoteContentManagerImpl> g_remote_manager_impl;
 
+        constinit bool g_is_content_manager_in_process = false;
+
     }
 
     void Initialize() {
         AMS_ASSERT(g_content_manager == nullptr);
         R_ABORT_UNLESS(ncmInitialize());
         g_content_manager = g_remote_manager_impl.GetShared();
+        g_is_content_manager_in_process = false;
     }
 
     void Finalize() {
@@ -42,6 +46,17 @@ namespace ams::ncm {
         AMS_ASSERT(g_content_manager == nullptr);
         g_content_manager = manager_object;
         AMS_ASSERT(g_content_manager != nullptr);
+        g_is_content_manager_in_process = true;
+    }
+
+    bool GetContentMetaDatabaseGeneration(u32 *out) {
+        /* Changes can only be tracked when the content meta databases are hosted by this process. */
+        if (!g_is_content_manager_in_process) {
+            return false;
+        }
+
+        *out = impl::GetContentMetaDatabaseGeneration();
+        return true;
     }
 
     /* Service API. */
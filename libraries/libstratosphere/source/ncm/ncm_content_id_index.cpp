@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) Atmosphère-NX
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stratosphere.hpp>
+#include "ncm_content_id_index.hpp"
+
+namespace ams::ncm {
+
+    namespace {
+
+        constexpr inline auto EntryIdLessThan = [](const auto &entry, const ContentId &id) ALWAYS_INLINE_LAMBDA {
+            return ContentIdLessThan{}(entry.id, id);
+        };
+
+    }
+
+    void ContentIdIndex::Invalidate() {
+        m_entries.reset();
+        m_count    = 0;
+        m_capacity = 0;
+        m_is_valid = false;
+    }
+
+    void ContentIdIndex::BeginBuild() {
+        this->Invalidate();
+    }
+
+    bool ContentIdIndex::AddForBuild(ContentId id) {
+        AMS_ASSERT(!m_is_valid);
+
+        /* Ensure we have space for the id. */
+        if (!this->Reserve(m_count + 1)) {
+            this->Invalidate();
+            return false;
+        }
+
+        m_entries[m_count++] = { id, UnknownSize };
+        return true;
+    }
+
+    void ContentIdIndex::EndBuild() {
+        AMS_ASSERT(!m_is_valid);
+
+        /* Sort the entries. */
+        std::sort(m_entries.get(), m_entries.get() + m_count, [](const Entry &lhs, const Entry &rhs) {
+            return ContentIdLessThan{}(lhs.id, rhs.id);
+        });
+
+        /* Remove any duplicates, which can only occur if the same content is present under multiple paths. */
+        m_count = std::unique(m_entries.get(), m_entries.get() + m_count, [](const Entry &lhs, const Entry &rhs) {
+            return lhs.id == rhs.id;
+        }) - m_entries.get();
+
+        m_is_valid = true;
+    }
+
+    bool ContentIdIndex::Has(ContentId id) const {
+        return this->Find(id) != nullptr;
+    }
+
+    bool ContentIdIndex::GetSize(s64 *out, ContentId id) const {
+        if (const auto *entry = this->Find(id); entry != nullptr && entry->size != UnknownSize) {
+            *out = entry->size;
+            return true;
+        }
+
+        return false;
+    }
+
+    void ContentIdIndex::SetSize(ContentId id, s64 size) {
+        if (auto *entry = this->Find(id); entry != nullptr) {
+            entry->size = size;
+        }
+    }
+
+    void ContentIdIndex::Insert(ContentId id) {
+        /* If we're not valid, there's nothing to maintain. */
+        if (!m_is_valid) {
+            return;
+        }
+
+        /* Find the position to insert at. If the id is already present, just forget its size. */
+        Entry *it = std::lower_bound(m_entries.get(), m_entries.get() + m_count, id, EntryIdLessThan);
+        if (it != m_entries.get() + m_count && it->id == id) {
+            it->size = UnknownSize;
+            return;
+        }
+
+        /* Ensure we have space for the id. */
+        const size_t index = it - m_entries.get();
+        if (!this->Reserve(m_count + 1)) {
+            this->Invalidate();
+            return;
+        }
+
+        /* Insert the entry. */
+        std::memmove(m_entries.get() + index + 1, m_entries.get() + index, sizeof(Entry) * (m_count - index));
+        m_entries[index] = { id, UnknownSize };
+        ++m_count;
+    }
+
+    void ContentIdIndex::Erase(ContentId id) {
+        if (Entry *entry = this->Find(id); entry != nullptr) {
+            const size_t index = entry - m_entries.get();
+            std::memmove(m_entries.get() + index, m_entries.get() + index + 1, sizeof(Entry) * (m_count - index - 1));
+            --m_count;
+        }
+    }
+
+    const ContentIdIndex::Entry *ContentIdIndex::Find(ContentId id) const {
+        if (!m_is_valid) {
+            return nullptr;
+        }
+
+        const Entry *it = std::lower_bound(m_entries.get(), m_entries.get() + m_count, id, EntryIdLessThan);
+        return (it != m_entries.get() + m_count && it->id == id) ? it : nullptr;
+    }
+
+    ContentIdIndex::Entry *ContentIdIndex::Find(ContentId id) {
+        return const_cast<Entry *>(static_cast<const ContentIdIndex *>(this)->Find(id));
+    }
+
+    bool ContentIdIndex::Reserve(size_t count) {
+        /* If we have enough space, we're done. */
+        if (count <= m_capacity) {
+            return true;
+        }
+
+        /* Allocate a larger buffer. */
+        const size_t new_capacity = std::max(std::max(count, InitialCapacity), m_capacity * 2);
+        std::unique_ptr<Entry[]> new_entries(new (std::nothrow) Entry[new_capacity]);
+        if (new_entries == nullptr) {
+            return false;
+        }
+
+        /* Move our entries to it. */
+        if (m_count > 0) {
+            std::memcpy(new_entries.get(), m_entries.get(), sizeof(Entry) * m_count);
+        }
+
+        m_entries  = std::move(new_entries);
+        m_capacity = new_capacity;
+        return true;
+    }
+
+}
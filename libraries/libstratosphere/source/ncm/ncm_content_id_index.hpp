@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Atmosphère-NX
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include <stratosphere.hpp>
+
+namespace ams::ncm {
+
+    struct ContentIdLessThan {
+        bool operator()(const ContentId &lhs, const ContentId &rhs) const {
+            return std::memcmp(lhs.uuid.data, rhs.uuid.data, sizeof(lhs.uuid.data)) < 0;
+        }
+    };
+
+    /* Sorted in-memory index of the contents registered in a content storage. */
+    /* If memory for the index can't be allocated, it becomes invalid, and the owner should fall back to querying the filesystem. */
+    class ContentIdIndex {
+        NON_COPYABLE(ContentIdIndex);
+        NON_MOVEABLE(ContentIdIndex);
+        public:
+            static constexpr s64 UnknownSize = -1;
+        private:
+            struct Entry {
+                ContentId id;
+                s64 size;
+            };
+
+            static constexpr size_t InitialCapacity = 0x40;
+        private:
+            std::unique_ptr<Entry[]> m_entries;
+            size_t m_count;
+            size_t m_capacity;
+            bool m_is_valid;
+        public:
+            ContentIdIndex() : m_entries(), m_count(0), m_capacity(0), m_is_valid(false) { /* ... */ }
+
+            bool IsValid() const {
+                return m_is_valid;
+            }
+
+            size_t GetCount() const {
+                AMS_ASSERT(m_is_valid);
+                return m_count;
+            }
+
+            ContentId GetId(size_t index) const {
+                AMS_ASSERT(m_is_valid);
+                AMS_ASSERT(index < m_count);
+                return m_entries[index].id;
+            }
+
+            void Invalidate();
+
+            /* Building is done by adding ids in any order, then sorting them once. */
+            void BeginBuild();
+            bool AddForBuild(ContentId id);
+            void EndBuild();
+
+            bool Has(ContentId id) const;
+            bool GetSize(s64 *out, ContentId id) const;
+            void SetSize(ContentId id, s64 size);
+
+            void Insert(ContentId id);
+            void Erase(ContentId id);
+        private:
+            const Entry *Find(ContentId id) const;
+            Entry *Find(ContentId id);
+            bool Reserve(size_t count);
+    };
+
+}
@@ -19,6 +19,7 @@
 #include "ncm_host_content_storage_impl.hpp"
 #include "ncm_content_meta_database_impl.hpp"
 #include "ncm_on_memory_content_meta_database_impl.hpp"
+#include "ncm_content_meta_database_generation.hpp"
 #include "ncm_fs_utils.hpp"
 
 namespace ams::ncm {
@@ -321,6 +322,9 @@ namespace ams::ncm {
         /* Check if we've already initialized. */
         R_SUCCEED_IF(m_initialized);
 
+        /* Set whether content storages should index their contents in memory. */
+        m_content_id_index_enabled = config.ShouldEnableContentIdIndex();
+
         /* Clear storage id for all roots. */
         for (auto &root : m_content_storage_roots) {
             root.storage_id = StorageId::None;
@@ -578,6 +582,11 @@ namespace ams::ncm {
                     break;
             }
 
+            /* Enable the content id index, if we should. */
+            if (m_content_id_index_enabled) {
+                content_storage.GetImpl().EnableContentIdIndex();
+            }
+
             root->content_storage = std::move(content_storage);
         }
 
@@ -644,6 +653,9 @@ namespace ams::ncm {
             mount_guard.Cancel();
         }
 
+        /* Any resolutions made against the previous database are no longer accurate. */
+        impl::NotifyContentMetaDatabaseChanged();
+
         return ResultSuccess();
     }
 
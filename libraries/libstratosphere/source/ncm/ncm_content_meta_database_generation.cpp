@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) Atmosphère-NX
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stratosphere.hpp>
+#include "ncm_content_meta_database_generation.hpp"
+
+namespace ams::ncm::impl {
+
+    namespace {
+
+        constinit std::atomic<u32> g_content_meta_database_generation = 0;
+
+    }
+
+    u32 GetContentMetaDatabaseGeneration() {
+        return g_content_meta_database_generation.load(std::memory_order_acquire);
+    }
+
+    void NotifyContentMetaDatabaseChanged() {
+        g_content_meta_database_generation.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+}
@@ -15,6 +15,8 @@
  */
 #include <stratosphere.hpp>
 #include "ncm_content_meta_database_impl.hpp"
+#include "ncm_content_id_index.hpp"
+#include "ncm_content_meta_database_generation.hpp"
 
 namespace ams::ncm {
 
@@ -51,6 +53,12 @@ namespace ams::ncm {
 
     Result ContentMetaDatabaseImpl::Set(const ContentMetaKey &key, const sf::InBuffer &value) {
         R_TRY(this->EnsureEnabled());
+
+        /* Any cached resolutions may no longer be accurate. */
+        ON_SCOPE_EXIT { impl::NotifyContentMetaDatabaseChanged(); };
+
+        /* Stage the mutation, so that many sets before a commit are merged in a single pass. */
+        m_kvs->BeginBatch();
         return m_kvs->Set(key, value.GetPointer(), value.GetSize());
     }
 
@@ -70,6 +78,11 @@ namespace ams::ncm {
     Result ContentMetaDatabaseImpl::Remove(const ContentMetaKey &key) {
         R_TRY(this->EnsureEnabled());
 
+        /* Any cached resolutions may no longer be accurate. */
+        ON_SCOPE_EXIT { impl::NotifyContentMetaDatabaseChanged(); };
+
+        /* Stage the mutation, so that many removals before a commit are merged in a single pass. */
+        m_kvs->BeginBatch();
         R_TRY_CATCH(m_kvs->Remove(key)) {
             R_CONVERT(kvdb::ResultKeyNotFound, ncm::ResultContentMetaNotFound())
         } R_END_TRY_CATCH;
@@ -296,6 +309,7 @@ namespace ams::ncm {
 
     Result ContentMetaDatabaseImpl::DisableForcibly() {
         m_disabled = true;
+        impl::NotifyContentMetaDatabaseChanged();
         return ResultSuccess();
     }
 
@@ -308,8 +322,38 @@ namespace ams::ncm {
             out_orphaned[i] = true;
         }
 
-        auto IsOrphanedContent = [](const sf::InArray<ContentId> &list, const ncm::ContentId &id) ALWAYS_INLINE_LAMBDA -> util::optional<size_t> {
-            /* Check if any input content ids match our found content id. */
+        /* Sort the indices of the content ids to look up, so that each content can be found with a binary search. */
+        /* NOTE: Ties are broken by index, so that the first matching input is found, as with a linear search. */
+        const size_t lookup_count = content_ids.GetSize();
+        std::unique_ptr<u32[]> sorted_indices(new (std::nothrow) u32[lookup_count]);
+        if (sorted_indices != nullptr) {
+            for (size_t i = 0; i < lookup_count; i++) {
+                sorted_indices[i] = static_cast<u32>(i);
+            }
+
+            std::sort(sorted_indices.get(), sorted_indices.get() + lookup_count, [&](u32 lhs, u32 rhs) {
+                if (content_ids[lhs] == content_ids[rhs]) {
+                    return lhs < rhs;
+                }
+                return ContentIdLessThan{}(content_ids[lhs], content_ids[rhs]);
+            });
+        }
+
+        auto IsOrphanedContent = [&](const sf::InArray<ContentId> &list, const ncm::ContentId &id) ALWAYS_INLINE_LAMBDA -> util::optional<size_t> {
+            /* If we have sorted indices, search them. */
+            if (sorted_indices != nullptr) {
+                const auto it = std::lower_bound(sorted_indices.get(), sorted_indices.get() + lookup_count, id, [&](u32 index, const ncm::ContentId &target) {
+                    return ContentIdLessThan{}(list[index], target);
+                });
+
+                if (it != sorted_indices.get() + lookup_count && list[*it] == id) {
+                    return util::make_optional(static_cast<size_t>(*it));
+                }
+
+                return util::nullopt;
+            }
+
+            /* Otherwise, check if any input content ids match our found content id. */
             for (size_t i = 0; i < list.GetSize(); i++) {
                 if (list[i] == id) {
                     return util::make_optional(i);
@@ -338,6 +382,12 @@ namespace ams::ncm {
     Result ContentMetaDatabaseImpl::Commit() {
         R_TRY(this->EnsureEnabled());
 
+        /* Any cached resolutions may no longer be accurate. */
+        ON_SCOPE_EXIT { impl::NotifyContentMetaDatabaseChanged(); };
+
+        /* Merge any staged mutations. */
+        m_kvs->EndBatch();
+
         /* Save and commit. */
         R_TRY(m_kvs->Save());
         return fs::CommitSaveData(m_mount_name);
@@ -376,6 +376,51 @@ namespace ams::ncm {
         return ResultSuccess();
     }
 
+    bool ContentStorageImpl::EnsureContentIdIndex() {
+        /* If the index isn't enabled, we can't use it. */
+        if (!m_content_id_index_enabled) {
+            return false;
+        }
+
+        /* If the index is already built, we can use it. */
+        if (m_content_id_index.IsValid()) {
+            return true;
+        }
+
+        /* Obtain the content base directory path. */
+        PathString path;
+        MakeBaseContentDirectoryPath(std::addressof(path), m_root_path);
+
+        /* Traverse the content base directory, adding all contents to the index. */
+        bool added_all = true;
+        m_content_id_index.BeginBuild();
+        const Result result = TraverseDirectory(path, GetHierarchicalContentDirectoryDepth(m_make_content_path_func), [&](bool *should_continue, bool *should_retry_dir_read, const char *current_path, const fs::DirectoryEntry &entry) -> Result {
+            AMS_UNUSED(current_path);
+
+            *should_retry_dir_read = false;
+            *should_continue       = true;
+
+            /* Add each content file, stopping if we run out of memory. */
+            if (entry.type == fs::DirectoryEntryType_File) {
+                if (auto content_id = GetContentIdFromString(entry.name, std::strlen(entry.name)); content_id.has_value()) {
+                    added_all        = m_content_id_index.AddForBuild(*content_id);
+                    *should_continue = added_all;
+                }
+            }
+
+            return ResultSuccess();
+        });
+
+        /* If we failed to add every content, we can't use the index. */
+        if (R_FAILED(result) || !added_all) {
+            m_content_id_index.Invalidate();
+            return false;
+        }
+
+        m_content_id_index.EndBuild();
+        return true;
+    }
+
     Result ContentStorageImpl::Initialize(const char *path, MakeContentPathFunction content_path_func, MakePlaceHolderPathFunction placeholder_path_func, bool delay_flush, RightsIdCache *rights_id_cache) {
         R_TRY(this->EnsureEnabled());
 
@@ -446,18 +491,36 @@ namespace ams::ncm {
             R_CONVERT(fs::ResultPathAlreadyExists, ncm::ResultContentAlreadyExists())
         } R_END_TRY_CATCH;
 
+        /* Add the content to our index. */
+        m_content_id_index.Insert(content_id);
+
         return ResultSuccess();
     }
 
     Result ContentStorageImpl::Delete(ContentId content_id) {
         R_TRY(this->EnsureEnabled());
         this->InvalidateFileCache();
-        return DeleteContentFile(content_id, m_make_content_path_func, m_root_path);
+
+        /* Delete the content file. */
+        const Result result = DeleteContentFile(content_id, m_make_content_path_func, m_root_path);
+
+        /* If the content no longer exists, remove it from our index. */
+        if (R_SUCCEEDED(result) || ncm::ResultContentNotFound::Includes(result)) {
+            m_content_id_index.Erase(content_id);
+        }
+
+        return result;
     }
 
     Result ContentStorageImpl::Has(sf::Out<bool> out, ContentId content_id) {
         R_TRY(this->EnsureEnabled());
 
+        /* If we have an index, use it. */
+        if (this->EnsureContentIdIndex()) {
+            out.SetValue(m_content_id_index.Has(content_id));
+            return ResultSuccess();
+        }
+
         /* Create the content path. */
         PathString content_path;
         MakeContentPath(std::addressof(content_path), content_id, m_make_content_path_func, m_root_path);
@@ -552,6 +615,12 @@ namespace ams::ncm {
     Result ContentStorageImpl::GetContentCount(sf::Out<s32> out_count) {
         R_TRY(this->EnsureEnabled());
 
+        /* If we have an index, use it. */
+        if (this->EnsureContentIdIndex()) {
+            out_count.SetValue(static_cast<s32>(m_content_id_index.GetCount()));
+            return ResultSuccess();
+        }
+
         /* Obtain the content base directory path. */
         PathString path;
         MakeBaseContentDirectoryPath(std::addressof(path), m_root_path);
@@ -582,6 +651,17 @@ namespace ams::ncm {
         R_UNLESS(offset >= 0, ncm::ResultInvalidOffset());
         R_TRY(this->EnsureEnabled());
 
+        /* If we have an index, list the contents from it. */
+        if (this->EnsureContentIdIndex()) {
+            s32 count = 0;
+            for (size_t i = static_cast<size_t>(offset); i < m_content_id_index.GetCount() && count < static_cast<s32>(out.GetSize()); ++i) {
+                out[count++] = m_content_id_index.GetId(i);
+            }
+
+            *out_count = count;
+            return ResultSuccess();
+        }
+
         if (!m_content_iterator.has_value() || !m_last_content_offset.has_value() || m_last_content_offset != offset) {
             /* Create and initialize the content cache. */
             m_content_iterator.emplace();
@@ -637,6 +717,11 @@ namespace ams::ncm {
     Result ContentStorageImpl::GetSizeFromContentId(sf::Out<s64> out_size, ContentId content_id) {
         R_TRY(this->EnsureEnabled());
 
+        /* If our index knows the size of the content, use it. */
+        if (m_content_id_index.GetSize(out_size.GetPointer(), content_id)) {
+            return ResultSuccess();
+        }
+
         /* Create the content path. */
         PathString content_path;
         MakeContentPath(std::addressof(content_path), content_id, m_make_content_path_func, m_root_path);
@@ -650,6 +735,9 @@ namespace ams::ncm {
         s64 file_size;
         R_TRY(fs::GetFileSize(std::addressof(file_size), file));
 
+        /* Remember the size in our index. */
+        m_content_id_index.SetSize(content_id, file_size);
+
         out_size.SetValue(file_size);
         return ResultSuccess();
     }
@@ -658,6 +746,7 @@ namespace ams::ncm {
         m_disabled = true;
         this->InvalidateFileCache();
         m_placeholder_accessor.InvalidateAll();
+        m_content_id_index.Invalidate();
         return ResultSuccess();
     }
 
@@ -687,6 +776,9 @@ namespace ams::ncm {
             R_CONVERT(fs::ResultPathAlreadyExists, ncm::ResultContentAlreadyExists())
         } R_END_TRY_CATCH;
 
+        /* The old content is no longer registered. */
+        m_content_id_index.Erase(old_content_id);
+
         return ResultSuccess();
     }
 
@@ -786,7 +878,12 @@ namespace ams::ncm {
         ON_SCOPE_EXIT { fs::CloseFile(file); };
 
         /* Write the provided data to the file. */
-        return fs::WriteFile(file, offset, data.GetPointer(), data.GetSize(), fs::WriteOption::Flush);
+        R_TRY(fs::WriteFile(file, offset, data.GetPointer(), data.GetSize(), fs::WriteOption::Flush));
+
+        /* The size of the content may have changed. */
+        m_content_id_index.SetSize(content_id, ContentIdIndex::UnknownSize);
+
+        return ResultSuccess();
     }
 
     Result ContentStorageImpl::GetFreeSpaceSize(sf::Out<s64> out_size) {
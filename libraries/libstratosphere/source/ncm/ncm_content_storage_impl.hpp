@@ -18,6 +18,7 @@
 
 #include "ncm_content_storage_impl_base.hpp"
 #include "ncm_placeholder_accessor.hpp"
+#include "ncm_content_id_index.hpp"
 
 namespace ams::ncm {
 
@@ -55,19 +56,26 @@ namespace ams::ncm {
             RightsIdCache *m_rights_id_cache;
             util::optional<ContentIterator> m_content_iterator;
             util::optional<s32> m_last_content_offset;
+            ContentIdIndex m_content_id_index;
+            bool m_content_id_index_enabled;
         public:
             static Result InitializeBase(const char *root_path);
             static Result CleanupBase(const char *root_path);
             static Result VerifyBase(const char *root_path);
         public:
-            ContentStorageImpl() : m_placeholder_accessor(), m_cached_content_id(InvalidContentId), m_cached_file_handle(), m_rights_id_cache(nullptr), m_content_iterator(util::nullopt), m_last_content_offset(util::nullopt) { /* ... */ }
+            ContentStorageImpl() : m_placeholder_accessor(), m_cached_content_id(InvalidContentId), m_cached_file_handle(), m_rights_id_cache(nullptr), m_content_iterator(util::nullopt), m_last_content_offset(util::nullopt), m_content_id_index(), m_content_id_index_enabled(false) { /* ... */ }
             ~ContentStorageImpl();
 
             Result Initialize(const char *root_path, MakeContentPathFunction content_path_func, MakePlaceHolderPathFunction placeholder_path_func, bool delay_flush, RightsIdCache *rights_id_cache);
+
+            void EnableContentIdIndex() {
+                m_content_id_index_enabled = true;
+            }
         private:
             /* Helpers. */
             Result OpenContentIdFile(ContentId content_id);
             void InvalidateFileCache();
+            bool EnsureContentIdIndex();
         public:
             /* Actual commands. */
             virtual Result GeneratePlaceHolderId(sf::Out<PlaceHolderId> out) override;
@@ -542,6 +542,15 @@ namespace ams::ncm {
     }
 
     Result InstallTaskBase::WritePlaceHolderBuffer(InstallContentInfo *content_info, const void *data, size_t data_size) {
+        /* Write the data. */
+        R_TRY(this->WritePlaceHolderBufferWithoutHash(content_info, data, data_size));
+
+        /* Update the hash for the new data. */
+        this->UpdatePlaceHolderHash(data, data_size);
+        return ResultSuccess();
+    }
+
+    Result InstallTaskBase::WritePlaceHolderBufferWithoutHash(InstallContentInfo *content_info, const void *data, size_t data_size) {
         R_UNLESS(!this->IsCancelRequested(), ncm::ResultWritePlaceHolderCancelled());
 
         /* Open the content storage for the content info. */
@@ -558,11 +567,24 @@ namespace ams::ncm {
             this->UpdateThroughputMeasurement(data_size);
         }
 
-        /* Update the hash for the new data. */
-        m_sha256_generator.Update(data, data_size);
         return ResultSuccess();
     }
 
+    void InstallTaskBase::UpdatePlaceHolderHash(const void *data, size_t data_size) {
+        m_sha256_generator.Update(data, data_size);
+    }
+
+    void InstallTaskBase::GetPlaceHolderHashState(PlaceHolderHashState *out) const {
+        m_sha256_generator.GetContext(std::addressof(out->context));
+        out->buffered_data_size = m_sha256_generator.GetBufferedDataSize();
+        m_sha256_generator.GetBufferedData(out->buffered_data, out->buffered_data_size);
+    }
+
+    void InstallTaskBase::RestorePlaceHolderHashState(const PlaceHolderHashState &state) {
+        m_sha256_generator.InitializeWithContext(std::addressof(state.context));
+        m_sha256_generator.Update(state.buffered_data, state.buffered_data_size);
+    }
+
     Result InstallTaskBase::WritePlaceHolder(const ContentMetaKey &key, InstallContentInfo *content_info) {
         if (content_info->is_sha256_calculated) {
             /* Update the hash with the buffered data. */
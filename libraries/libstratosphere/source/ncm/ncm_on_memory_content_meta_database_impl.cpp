@@ -94,6 +94,9 @@ namespace ams::ncm {
 
     Result OnMemoryContentMetaDatabaseImpl::Commit() {
         R_TRY(this->EnsureEnabled());
+
+        /* Merge any staged mutations. */
+        m_kvs->EndBatch();
         return ResultSuccess();
     }
 
@@ -17,14 +17,147 @@
 
 namespace ams::ncm {
 
+    namespace {
+
+        /* The writer's stack is carved out of the install buffer, so we only pipeline when the buffer is large enough to spare it. */
+        constexpr size_t PlaceHolderWriterStackSize  = 16_KB;
+        constexpr size_t MinimumPipelinedChunkSize   = 64_KB;
+        constexpr s32    PlaceHolderWriterChunkCount = 2;
+
+        template<typename WriteFunction>
+        class PlaceHolderWriter {
+            NON_COPYABLE(PlaceHolderWriter);
+            NON_MOVEABLE(PlaceHolderWriter);
+            private:
+                struct Chunk {
+                    const void *data;
+                    size_t size;
+                    bool is_filled;
+                };
+            private:
+                WriteFunction m_write;
+                os::ThreadType m_thread;
+                os::SdkMutex m_mutex;
+                os::SdkConditionVariable m_cv;
+                Chunk m_chunks[PlaceHolderWriterChunkCount];
+                s32 m_next_write_index;
+                s32 m_written_count;
+                Result m_result;
+                bool m_is_finished;
+            public:
+                explicit PlaceHolderWriter(WriteFunction write) : m_write(write), m_thread(), m_mutex(), m_cv(), m_chunks(), m_next_write_index(0), m_written_count(0), m_result(ResultSuccess()), m_is_finished(false) { /* ... */ }
+
+                Result Start(void *stack, size_t stack_size) {
+                    /* The writer runs at our priority, so that neither stage starves the other. */
+                    R_TRY(os::CreateThread(std::addressof(m_thread), ThreadFunction, this, stack, stack_size, os::GetThreadPriority(os::GetCurrentThread())));
+                    os::SetThreadNamePointer(std::addressof(m_thread), AMS_GET_SYSTEM_THREAD_NAME(ncm, PlaceHolderWriter));
+                    os::StartThread(std::addressof(m_thread));
+                    return ResultSuccess();
+                }
+
+                Result WaitForChunk(s32 index) {
+                    std::scoped_lock lk(m_mutex);
+
+                    /* Wait for the writer to be done with the chunk, or to fail. */
+                    while (m_chunks[index].is_filled && R_SUCCEEDED(m_result)) {
+                        m_cv.Wait(m_mutex);
+                    }
+
+                    return m_result;
+                }
+
+                void Submit(s32 index, const void *data, size_t size) {
+                    std::scoped_lock lk(m_mutex);
+                    AMS_ASSERT(!m_chunks[index].is_filled);
+
+                    m_chunks[index] = { data, size, true };
+                    m_cv.Broadcast();
+                }
+
+                Result Finish(s32 *out_written_count) {
+                    /* Let the writer drain any submitted chunks, then exit. */
+                    {
+                        std::scoped_lock lk(m_mutex);
+                        m_is_finished = true;
+                        m_cv.Broadcast();
+                    }
+
+                    os::WaitThread(std::addressof(m_thread));
+                    os::DestroyThread(std::addressof(m_thread));
+
+                    *out_written_count = m_written_count;
+                    return m_result;
+                }
+            private:
+                static void ThreadFunction(void *arg) {
+                    static_cast<PlaceHolderWriter *>(arg)->ThreadFunctionImpl();
+                }
+
+                void ThreadFunctionImpl() {
+                    while (true) {
+                        /* Wait for the next chunk in order. */
+                        Chunk chunk;
+                        {
+                            std::scoped_lock lk(m_mutex);
+                            while (!m_chunks[m_next_write_index].is_filled && !m_is_finished) {
+                                m_cv.Wait(m_mutex);
+                            }
+
+                            if (!m_chunks[m_next_write_index].is_filled) {
+                                return;
+                            }
+
+                            chunk = m_chunks[m_next_write_index];
+                        }
+
+                        /* Write the chunk. */
+                        const Result result = m_write(chunk.data, chunk.size);
+
+                        /* Release the chunk, or stop on failure. */
+                        std::scoped_lock lk(m_mutex);
+                        if (R_FAILED(result)) {
+                            m_result = result;
+                            m_cv.Broadcast();
+                            return;
+                        }
+
+                        m_chunks[m_next_write_index].is_filled = false;
+                        m_next_write_index = (m_next_write_index + 1) % PlaceHolderWriterChunkCount;
+                        ++m_written_count;
+                        m_cv.Broadcast();
+                    }
+                }
+        };
+
+    }
+
     Result PackageInstallTaskBase::Initialize(const char *package_root_path, void *buffer, size_t buffer_size, StorageId storage_id, InstallTaskDataBase *data, u32 config) {
         R_TRY(InstallTaskBase::Initialize(storage_id, data, config));
         m_package_root.Set(package_root_path);
         m_buffer = buffer;
         m_buffer_size = buffer_size;
+
+        {
+            std::scoped_lock lk(m_stage_throughput_mutex);
+            m_stage_throughput = {};
+        }
+
         return ResultSuccess();
     }
 
+    PackageInstallThroughput PackageInstallTaskBase::GetStageThroughput() {
+        std::scoped_lock lk(m_stage_throughput_mutex);
+        return m_stage_throughput;
+    }
+
+    void PackageInstallTaskBase::UpdateStageThroughput(InstallThroughput PackageInstallThroughput::*stage, s64 size, TimeSpan elapsed_time) {
+        std::scoped_lock lk(m_stage_throughput_mutex);
+
+        auto &throughput = m_stage_throughput.*stage;
+        throughput.installed    += size;
+        throughput.elapsed_time += elapsed_time;
+    }
+
     Result PackageInstallTaskBase::OnWritePlaceHolder(const ContentMetaKey &key, InstallContentInfo *content_info) {
         AMS_UNUSED(key);
 
@@ -41,11 +174,22 @@ namespace ams::ncm {
         R_TRY(fs::OpenFile(std::addressof(file), path, fs::OpenMode_Read));
         ON_SCOPE_EXIT { fs::CloseFile(file); };
 
+        /* Overlap reading and hashing with writing, if we can. */
+        bool pipelined;
+        R_TRY(this->WritePlaceHolderFromFilePipelined(std::addressof(pipelined), content_info, file));
+        R_SUCCEED_IF(pipelined);
+
+        return this->WritePlaceHolderFromFile(content_info, file);
+    }
+
+    Result PackageInstallTaskBase::WritePlaceHolderFromFile(InstallContentInfo *content_info, fs::FileHandle file) {
         /* Continuously write the file to the placeholder until there is nothing left to write. */
         while (true) {
             /* Read as much of the remainder of the file as possible. */
             size_t size_read;
+            const auto read_start = os::GetSystemTick();
             R_TRY(fs::ReadFile(std::addressof(size_read), file, content_info->written, m_buffer, m_buffer_size));
+            this->UpdateStageThroughput(&PackageInstallThroughput::read, size_read, (os::GetSystemTick() - read_start).ToTimeSpan());
 
             /* There is nothing left to read. */
             if (size_read == 0) {
@@ -53,12 +197,98 @@ namespace ams::ncm {
             }
 
             /* Write the placeholder. */
-            R_TRY(this->WritePlaceHolderBuffer(content_info, m_buffer, size_read));
+            const auto write_start = os::GetSystemTick();
+            R_TRY(this->WritePlaceHolderBufferWithoutHash(content_info, m_buffer, size_read));
+            this->UpdateStageThroughput(&PackageInstallThroughput::write, size_read, (os::GetSystemTick() - write_start).ToTimeSpan());
+
+            /* Update the hash for the new data. */
+            const auto hash_start = os::GetSystemTick();
+            this->UpdatePlaceHolderHash(m_buffer, size_read);
+            this->UpdateStageThroughput(&PackageInstallThroughput::hash, size_read, (os::GetSystemTick() - hash_start).ToTimeSpan());
         }
 
         return ResultSuccess();
     }
 
+    Result PackageInstallTaskBase::WritePlaceHolderFromFilePipelined(bool *out_pipelined, InstallContentInfo *content_info, fs::FileHandle file) {
+        *out_pipelined = false;
+
+        /* Carve the writer stack and the chunks out of our buffer. */
+        /* NOTE: Chunks are kept page-aligned, so that reads and writes of whole chunks are aligned transfers. */
+        const uintptr_t buffer_start = reinterpret_cast<uintptr_t>(m_buffer);
+        const uintptr_t buffer_end   = buffer_start + m_buffer_size;
+        const uintptr_t stack_start  = util::AlignUp(buffer_start, os::ThreadStackAlignment);
+        const uintptr_t chunks_start = util::AlignUp(stack_start + PlaceHolderWriterStackSize, os::MemoryPageSize);
+        R_SUCCEED_IF(chunks_start >= buffer_end);
+
+        const size_t chunk_size = util::AlignDown((buffer_end - chunks_start) / PlaceHolderWriterChunkCount, os::MemoryPageSize);
+        R_SUCCEED_IF(chunk_size < MinimumPipelinedChunkSize);
+
+        /* Create the writer. */
+        auto write = [&](const void *data, size_t size) -> Result {
+            const auto write_start = os::GetSystemTick();
+            R_TRY(this->WritePlaceHolderBufferWithoutHash(content_info, data, size));
+            this->UpdateStageThroughput(&PackageInstallThroughput::write, size, (os::GetSystemTick() - write_start).ToTimeSpan());
+            return ResultSuccess();
+        };
+        PlaceHolderWriter<decltype(write)> writer(write);
+        R_SUCCEED_IF(R_FAILED(writer.Start(reinterpret_cast<void *>(stack_start), PlaceHolderWriterStackSize)));
+        *out_pipelined = true;
+
+        /* Read and hash each chunk, while the writer writes the previous one. */
+        PlaceHolderHashState hash_states[PlaceHolderWriterChunkCount];
+        s64 offset = content_info->written;
+        s32 submitted_count = 0;
+        Result read_result = ResultSuccess();
+        while (true) {
+            const s32 index = submitted_count % PlaceHolderWriterChunkCount;
+            char *chunk = reinterpret_cast<char *>(chunks_start + index * chunk_size);
+
+            /* Wait for the chunk to be free. If the writer failed, there's no point continuing. */
+            if (R_FAILED(writer.WaitForChunk(index))) {
+                break;
+            }
+
+            /* Read as much of the remainder of the file as fits in the chunk. */
+            size_t size_read;
+            const auto read_start = os::GetSystemTick();
+            read_result = fs::ReadFile(std::addressof(size_read), file, offset, chunk, chunk_size);
+            if (R_FAILED(read_result)) {
+                break;
+            }
+            this->UpdateStageThroughput(&PackageInstallThroughput::read, size_read, (os::GetSystemTick() - read_start).ToTimeSpan());
+
+            /* There is nothing left to read. */
+            if (size_read == 0) {
+                break;
+            }
+
+            /* Hash the chunk, remembering where the hash stood in case it is never written. */
+            this->GetPlaceHolderHashState(std::addressof(hash_states[index]));
+
+            const auto hash_start = os::GetSystemTick();
+            this->UpdatePlaceHolderHash(chunk, size_read);
+            this->UpdateStageThroughput(&PackageInstallThroughput::hash, size_read, (os::GetSystemTick() - hash_start).ToTimeSpan());
+
+            /* Hand the chunk to the writer. */
+            writer.Submit(index, chunk, size_read);
+            offset += size_read;
+            ++submitted_count;
+        }
+
+        /* Wait for the writer to finish. */
+        s32 written_count;
+        const Result write_result = writer.Finish(std::addressof(written_count));
+
+        /* The hash must only cover what was actually written, so that resuming produces the correct digest. */
+        if (written_count < submitted_count) {
+            this->RestorePlaceHolderHashState(hash_states[written_count % PlaceHolderWriterChunkCount]);
+        }
+
+        R_TRY(write_result);
+        return read_result;
+    }
+
     Result PackageInstallTaskBase::InstallTicket(const fs::RightsId &rights_id, ContentMetaType meta_type) {
         AMS_UNUSED(meta_type);
 
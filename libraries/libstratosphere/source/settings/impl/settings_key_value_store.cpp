@@ -35,15 +35,18 @@ namespace ams::settings::impl {
         /* Type forward declarations. */
         class MapKey;
         struct MapValue;
-        template<typename T>
-        class Allocator;
-        using Map = std::map<MapKey, MapValue, std::less<MapKey>, Allocator<std::pair<const MapKey, MapValue>>>;
+        class MapArena;
+        class Map;
 
         /* Function forward declarations. */
         void FreeMapValueToHeap(const MapValue &value);
+        void FreeValueToHeap(void *value, size_t value_size);
         void *AllocateFromHeap(size_t size);
+        void *AllocateFromHeapTail(size_t size);
+        bool ResizeHeapBlock(void *block, size_t size);
         void FreeToHeap(void *block, size_t size);
         lmem::HeapHandle &GetHeapHandle();
+        MapArena &GetMapArena();
         Result GetKeyValueStoreMap(Map **out);
         Result GetKeyValueStoreMap(Map **out, bool force_load);
         Result GetKeyValueStoreMapForciblyForDebug(Map **out);
@@ -72,111 +75,92 @@ namespace ams::settings::impl {
             struct PfCfg{};
         };
 
+        /* NOTE: Map keys do not own their characters. Keys stored in the map point into the map arena, */
+        /* and keys used for lookup point into a MapKeyBuffer on the stack (or into an iterator's buffer). */
         class MapKey {
             public:
                 static constexpr size_t MaxKeySize = sizeof(SettingsName) + sizeof(SettingsItemKey);
             private:
-                char *m_chars;
-                size_t m_count;
+                const char *m_chars;
+                s32 m_count;
             public:
-                MapKey(const char * const chars) : m_chars(nullptr), m_count(0) {
+                constexpr MapKey() : m_chars(""), m_count(0) { /* ... */ }
+
+                MapKey(const char * const chars) : m_chars(chars), m_count(static_cast<s32>(util::Strnlen(chars, MaxKeySize))) {
                     AMS_ASSERT(chars != nullptr);
-                    this->Assign(chars, util::Strnlen(chars, MaxKeySize));
                 }
 
-                MapKey(const char * const chars, s32 count) : m_chars(nullptr), m_count(0) {
+                MapKey(const char * const chars, s32 count) : m_chars(chars), m_count(count) {
                     AMS_ASSERT(chars != nullptr);
                     AMS_ASSERT(count >= 0);
-                    this->Assign(chars, count);
-                }
-
-                MapKey(MapKey &&other) : m_chars(nullptr), m_count(0) {
-                    std::swap(m_chars, other.m_chars);
-                    std::swap(m_count, other.m_count);
                 }
 
-                MapKey(const MapKey &other) : m_chars(nullptr), m_count(0) {
-                    this->Assign(other.GetString(), other.GetCount());
+                size_t Find(const MapKey &other) const {
+                    return std::search(this->GetString(), this->GetString() + this->GetCount(), other.GetString(), other.GetString() + other.GetCount()) - this->GetString();
                 }
 
-                ~MapKey() {
-                    this->Reset();
+                s32 GetCount() const {
+                    return m_count;
                 }
 
-                MapKey &Append(char c) {
-                    const char chars[2] = { c, 0 };
-                    return this->Append(chars, 1);
+                const char *GetString() const {
+                    return m_chars;
                 }
+        };
 
-                MapKey &Append(const char * const chars, s32 count) {
-                    AMS_ASSERT(chars != nullptr);
-                    AMS_ASSERT(count >= 0);
-
-                    /* Allocate the new key. */
-                    const size_t new_count = m_count + count;
-                    char *new_heap = static_cast<char *>(AllocateFromHeap(new_count));
+        inline bool operator<(const MapKey &lhs, const MapKey &rhs) {
+            return std::strncmp(lhs.GetString(), rhs.GetString(), std::max(lhs.GetCount(), rhs.GetCount())) < 0;
+        }
 
-                    /* Copy the existing string to the new heap. */
-                    std::memcpy(new_heap, this->GetString(), this->GetCount());
+        inline bool operator==(const MapKey &lhs, const MapKey &rhs) {
+            return lhs.GetCount() == rhs.GetCount() && std::memcmp(lhs.GetString(), rhs.GetString(), lhs.GetCount()) == 0;
+        }
 
-                    /* Copy the string to append to the new heap. */
-                    std::memcpy(new_heap + this->GetCount(), chars, count);
+        class MapKeyBuffer {
+            private:
+                char m_chars[MapKey::MaxKeySize + 1];
+                s32 m_count;
+            public:
+                MapKeyBuffer() : m_count(0) {
+                    m_chars[0] = '\x00';
+                }
 
-                    /* Null-terminate the new string. */
-                    new_heap[new_count - 1] = '\x00';
+                explicit MapKeyBuffer(const char * const chars) : MapKeyBuffer() {
+                    AMS_ASSERT(chars != nullptr);
+                    this->Append(chars, util::Strnlen(chars, MapKey::MaxKeySize));
+                }
 
-                    /* Reset and update the key. */
-                    this->Reset();
-                    m_count = new_count;
-                    m_chars = new_heap;
-                    return *this;
+                MapKeyBuffer &Append(char c) {
+                    return this->Append(std::addressof(c), 1);
                 }
 
-                MapKey &Assign(const char * const chars, s32 count) {
+                MapKeyBuffer &Append(const char * const chars, s32 count) {
                     AMS_ASSERT(chars != nullptr);
                     AMS_ASSERT(count >= 0);
 
-                    /* Reset the key. */
-                    this->Reset();
+                    /* Copy as many characters as fit in the buffer. */
+                    const s32 copy_count = std::min<s32>(count, static_cast<s32>(MapKey::MaxKeySize) - m_count);
+                    std::memcpy(m_chars + m_count, chars, copy_count);
 
-                    /* Update the count and allocate the buffer. */
-                    m_count = count + 1;
-                    m_chars = static_cast<char *>(AllocateFromHeap(m_count));
-
-                    /* Copy the characters to the buffer. */
-                    std::memcpy(m_chars, chars, count);
-                    m_chars[count] = '\x00';
+                    /* Update the count and null-terminate the new string. */
+                    m_count += copy_count;
+                    m_chars[m_count] = '\x00';
                     return *this;
                 }
 
-                size_t Find(const MapKey &other) const {
-                    return std::search(this->GetString(), this->GetString() + this->GetCount(), other.GetString(), other.GetString() + other.GetCount()) - this->GetString();
-                }
-
                 s32 GetCount() const {
-                    return static_cast<s32>(m_count) - 1;
+                    return m_count;
                 }
 
-                const char *GetString() const {
-                    return m_chars;
-                }
-            private:
-                void Reset() {
-                    if (m_chars != nullptr) {
-                        FreeToHeap(m_chars, m_count);
-                        m_chars = nullptr;
-                        m_count = 0;
-                    }
+                operator MapKey() const {
+                    return MapKey(m_chars, m_count);
                 }
         };
 
-        inline bool operator<(const MapKey &lhs, const MapKey &rhs) {
-            return std::strncmp(lhs.GetString(), rhs.GetString(), std::max(lhs.GetCount(), rhs.GetCount())) < 0;
-        }
-
-        MapKey MakeMapKey(const SettingsName &name, const SettingsItemKey &item_key) {
+        MapKeyBuffer MakeMapKey(const SettingsName &name, const SettingsItemKey &item_key) {
             /* Create a map key. */
-            MapKey key(name.value, util::Strnlen(name.value, util::size(name.value)));
+            MapKeyBuffer key;
+            key.Append(name.value, util::Strnlen(name.value, util::size(name.value)));
 
             /* Append the settings name separator followed by the item key. */
             key.Append(SettingsNameSeparator);
@@ -196,38 +180,210 @@ namespace ams::settings::impl {
         };
         static_assert(sizeof(MapValue) == 0x28);
 
-        template<typename T>
-        class Allocator {
+        /* The map arena holds the interned key strings and the default values, which are immutable once loaded. */
+        /* It is carved out of the tail of the heap in large chunks, so that the long-lived data does not fragment */
+        /* the head of the heap, which is used for current values and other short-lived allocations. */
+        class MapArena {
+            NON_COPYABLE(MapArena);
+            NON_MOVEABLE(MapArena);
+            private:
+                struct alignas(alignof(std::max_align_t)) Chunk {
+                    Chunk *next;
+                    size_t size;
+                    size_t used;
+                };
+                static_assert(util::IsAligned(sizeof(Chunk), alignof(std::max_align_t)));
+
+                static constexpr size_t ChunkSize = 8_KB;
+            private:
+                Chunk *m_head;
             public:
-                using value_type      = T;
-                using size_type       = size_t;
-                using difference_type = ptrdiff_t;
+                constexpr MapArena() : m_head(nullptr) { /* ... */ }
+
+                void *Allocate(size_t size) {
+                    /* Align the size, so that all allocations are suitably aligned. */
+                    size = util::AlignUp(size, alignof(std::max_align_t));
+
+                    /* If the current chunk doesn't have space, allocate a new chunk. */
+                    if (m_head == nullptr || m_head->size - m_head->used < size) {
+                        const size_t chunk_size = std::max(ChunkSize, sizeof(Chunk) + size);
+                        Chunk *chunk = static_cast<Chunk *>(AllocateFromHeapTail(chunk_size));
+                        if (chunk == nullptr) {
+                            return nullptr;
+                        }
+
+                        /* Link the chunk. */
+                        chunk->next = m_head;
+                        chunk->size = chunk_size;
+                        chunk->used = sizeof(Chunk);
+                        m_head      = chunk;
+                    }
+
+                    /* Allocate from the current chunk. */
+                    void *allocated = reinterpret_cast<u8 *>(m_head) + m_head->used;
+                    m_head->used += size;
+                    return allocated;
+                }
+
+                const char *Intern(const MapKey &key) {
+                    /* Allocate space for the key and its null terminator. */
+                    char *chars = static_cast<char *>(this->Allocate(key.GetCount() + 1));
+                    if (chars == nullptr) {
+                        return nullptr;
+                    }
+
+                    /* Copy the key. */
+                    std::memcpy(chars, key.GetString(), key.GetCount());
+                    chars[key.GetCount()] = '\x00';
+                    return chars;
+                }
+
+                bool Contains(const void *p) const {
+                    const uintptr_t address = reinterpret_cast<uintptr_t>(p);
+                    for (const Chunk *chunk = m_head; chunk != nullptr; chunk = chunk->next) {
+                        if (reinterpret_cast<uintptr_t>(chunk) <= address && address < reinterpret_cast<uintptr_t>(chunk) + chunk->size) {
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+
+                void Clear() {
+                    while (m_head != nullptr) {
+                        Chunk *next = m_head->next;
+                        FreeToHeap(m_head, m_head->size);
+                        m_head = next;
+                    }
+                }
+        };
+
+        /* The map is a sorted, contiguous array of entries. Lookups binary search the array, and keys are */
+        /* interned into the map arena. Settings data is stored in key order, so loading appends in the common case. */
+        class Map {
+            NON_COPYABLE(Map);
+            NON_MOVEABLE(Map);
+            public:
+                struct value_type {
+                    MapKey first;
+                    MapValue second;
+                };
+
+                using iterator       = value_type *;
+                using const_iterator = const value_type *;
+            private:
+                static constexpr size_t InitialCapacity = 0x100;
+            private:
+                value_type *m_entries;
+                size_t m_count;
+                size_t m_capacity;
             public:
-                Allocator() noexcept = default;
-                ~Allocator() noexcept = default;
+                constexpr Map() : m_entries(nullptr), m_count(0), m_capacity(0) { /* ... */ }
+
+                iterator begin() { return m_entries; }
+                const_iterator begin() const { return m_entries; }
+                iterator end() { return m_entries + m_count; }
+                const_iterator end() const { return m_entries + m_count; }
 
-                Allocator(const Allocator &) noexcept = default;
-                Allocator(Allocator &&) noexcept = default;
+                size_t size() const { return m_count; }
 
-                T *allocate(size_t n) noexcept {
-                    return static_cast<T *>(AllocateFromHeap(sizeof(T) * n));
+                iterator find(const MapKey &key) {
+                    const auto it = this->LowerBound(key);
+                    return (it != this->end() && it->first == key) ? it : this->end();
+                }
+
+                const_iterator find(const MapKey &key) const {
+                    return const_cast<Map *>(this)->find(key);
+                }
+
+                void clear() {
+                    /* Free the entries. */
+                    if (m_entries != nullptr) {
+                        FreeToHeap(m_entries, m_capacity * sizeof(value_type));
+                        m_entries  = nullptr;
+                        m_count    = 0;
+                        m_capacity = 0;
+                    }
+
+                    /* Free the interned keys and default values. */
+                    GetMapArena().Clear();
+                }
+
+                Result Insert(const MapKey &key, const MapValue &value) {
+                    /* Find the insertion point, preferring to append. */
+                    iterator it = (m_count == 0 || m_entries[m_count - 1].first < key) ? this->end() : this->LowerBound(key);
+
+                    /* If the key already exists, replace its value. */
+                    if (it != this->end() && it->first == key) {
+                        FreeMapValueToHeap(it->second);
+                        it->second = value;
+                        return ResultSuccess();
+                    }
+
+                    /* Ensure we have space for the new entry. */
+                    const size_t index = it - this->begin();
+                    R_UNLESS(this->Reserve(m_count + 1), settings::ResultSettingsItemValueAllocationFailed());
+
+                    /* Intern the key. */
+                    const char *chars = GetMapArena().Intern(key);
+                    R_UNLESS(chars != nullptr, settings::ResultSettingsItemKeyAllocationFailed());
+
+                    /* Insert the entry. */
+                    it = m_entries + index;
+                    std::memmove(it + 1, it, (m_count - index) * sizeof(value_type));
+                    *it = { MapKey(chars, key.GetCount()), value };
+                    ++m_count;
+
+                    return ResultSuccess();
                 }
 
-                void deallocate(T *p, size_t n) noexcept {
-                    FreeToHeap(p, sizeof(T) * n);
+                void ShrinkToFit() {
+                    /* Release any unused capacity in place. */
+                    if (m_entries != nullptr && m_count > 0 && m_count < m_capacity) {
+                        if (ResizeHeapBlock(m_entries, m_count * sizeof(value_type))) {
+                            m_capacity = m_count;
+                        }
+                    }
                 }
             private:
-                Allocator &operator=(const Allocator &) noexcept = default;
-                Allocator &operator=(Allocator &&) noexcept = default;
-        };
+                iterator LowerBound(const MapKey &key) {
+                    return std::lower_bound(this->begin(), this->end(), key, [](const value_type &entry, const MapKey &key) {
+                        return entry.first < key;
+                    });
+                }
 
-        template<class T, class U>
-        constexpr inline bool operator==(const Allocator<T> &, const Allocator<U> &) {
-            return true;
-        }
+                bool Reserve(size_t count) {
+                    /* If we already have the capacity, we're done. */
+                    if (count <= m_capacity) {
+                        return true;
+                    }
+
+                    /* Determine the new capacity. */
+                    const size_t new_capacity = std::max(count, std::max(InitialCapacity, m_capacity * 2));
 
-        constexpr inline size_t MapKeyBufferSize   = MapKey::MaxKeySize * 2;
-        constexpr inline size_t MapEntryBufferSize = 0x40 + sizeof(Map::value_type);
+                    /* Try to grow the entries in place, to avoid needing both the old and new array at once. */
+                    if (m_entries != nullptr && ResizeHeapBlock(m_entries, new_capacity * sizeof(value_type))) {
+                        m_capacity = new_capacity;
+                        return true;
+                    }
+
+                    /* Allocate new entries. */
+                    value_type *new_entries = static_cast<value_type *>(AllocateFromHeap(new_capacity * sizeof(value_type)));
+                    if (new_entries == nullptr) {
+                        return false;
+                    }
+
+                    /* Move the existing entries. */
+                    if (m_entries != nullptr) {
+                        std::memcpy(new_entries, m_entries, m_count * sizeof(value_type));
+                        FreeToHeap(m_entries, m_capacity * sizeof(value_type));
+                    }
+
+                    m_entries  = new_entries;
+                    m_capacity = new_capacity;
+                    return true;
+                }
+        };
+        static_assert(std::is_trivially_copyable<Map::value_type>::value);
 
         constexpr inline size_t HeapMemorySize = 512_KB;
 
@@ -265,13 +421,18 @@ namespace ams::settings::impl {
 
         void FreeMapValueToHeap(const MapValue &map_value) {
             /* Free the current value. */
-            if (map_value.current_value != nullptr && map_value.current_value != map_value.default_value) {
-                FreeToHeap(map_value.current_value, map_value.current_value_size);
+            if (map_value.current_value != map_value.default_value) {
+                FreeValueToHeap(map_value.current_value, map_value.current_value_size);
             }
 
             /* Free the default value. */
-            if (map_value.default_value != nullptr) {
-                FreeToHeap(map_value.default_value, map_value.default_value_size);
+            FreeValueToHeap(map_value.default_value, map_value.default_value_size);
+        }
+
+        void FreeValueToHeap(void *value, size_t value_size) {
+            /* Values which live in the map arena are freed when the map is cleared. */
+            if (value != nullptr && !GetMapArena().Contains(value)) {
+                FreeToHeap(value, value_size);
             }
         }
 
@@ -284,6 +445,14 @@ namespace ams::settings::impl {
             return lmem::AllocateFromExpHeap(GetHeapHandle(), size);
         }
 
+        void *AllocateFromHeapTail(size_t size) {
+            return lmem::AllocateFromExpHeap(GetHeapHandle(), size, -static_cast<s32>(alignof(std::max_align_t)));
+        }
+
+        bool ResizeHeapBlock(void *block, size_t size) {
+            return lmem::ResizeExpHeapMemoryBlock(GetHeapHandle(), block, size) >= size;
+        }
+
         size_t GetHeapAllocatableSize() {
             return lmem::GetExpHeapAllocatableSize(GetHeapHandle(), sizeof(void *));
         }
@@ -295,6 +464,12 @@ namespace ams::settings::impl {
             return s_heap_handle;
         }
 
+        MapArena &GetMapArena() {
+            AMS_FUNCTION_LOCAL_STATIC_CONSTINIT(MapArena, s_map_arena);
+
+            return s_map_arena;
+        }
+
         Result GetKeyValueStoreMap(Map **out) {
             /* Check preconditions. */
             AMS_ASSERT(out != nullptr);
@@ -474,6 +649,9 @@ namespace ams::settings::impl {
             /* Load the keys/values based on the hardware type. */
             R_TRY(LoadKeyValueStoreMap(out, GetSplHardwareType()));
 
+            /* The set of keys is now fixed, so release any unused entry capacity. */
+            out->ShrinkToFit();
+
             if (IsSplDevelopment()) {
                 /* Get the system save data. */
                 SystemSaveData *system_save_data = nullptr;
@@ -574,8 +752,8 @@ namespace ams::settings::impl {
                     std::swap(map_value.current_value, current_value_buffer);
 
                     /* Free the old buffer if it is no longer in use. */
-                    if (current_value_buffer != nullptr && current_value_buffer != map_value.default_value) {
-                        FreeToHeap(current_value_buffer, current_value_size);
+                    if (current_value_buffer != map_value.default_value) {
+                        FreeValueToHeap(current_value_buffer, current_value_size);
                     }
                 }
 
@@ -596,27 +774,12 @@ namespace ams::settings::impl {
 
             /* Load the map entries. */
             R_TRY(LoadKeyValueStoreMapEntries(out, data, [](Map &map, const MapKey &key, u8 type, const void *value_buffer, u32 value_size) -> Result {
-                /* Ensure there is sufficient memory for two keys. */
-                R_UNLESS(GetHeapAllocatableSize() >= MapKeyBufferSize, settings::ResultSettingsItemKeyAllocationFailed());
-
-                /* Copy the map key. */
-                MapKey default_key = key;
                 void *default_value_buffer = nullptr;
 
-                ON_SCOPE_EXIT {
-                    /* Free the value buffer if allocated. */
-                    if (default_value_buffer != nullptr) {
-                        FreeToHeap(default_value_buffer, value_size);
-                    }
-                };
-
                 if (value_size > 0) {
-                    /* Ensure there is sufficient memory for the value. */
-                    R_UNLESS(GetHeapAllocatableSize() >= value_size, settings::ResultSettingsItemValueAllocationFailed());
-
-                    /* Allocate the value buffer. */
-                    default_value_buffer = AllocateFromHeap(value_size);
-                    AMS_ASSERT(default_value_buffer != nullptr);
+                    /* Allocate the value buffer from the map arena, as default values are immutable. */
+                    default_value_buffer = GetMapArena().Allocate(value_size);
+                    R_UNLESS(default_value_buffer != nullptr, settings::ResultSettingsItemValueAllocationFailed());
 
                     /* Copy the value to the new value buffer. */
                     std::memcpy(default_value_buffer, value_buffer, value_size);
@@ -631,12 +794,8 @@ namespace ams::settings::impl {
                     .default_value      = default_value_buffer,
                 };
 
-                /* Ensure there is sufficient memory for the value. */
-                R_UNLESS(GetHeapAllocatableSize() >= MapEntryBufferSize, settings::ResultSettingsItemValueAllocationFailed());
-
                 /* Insert the value into the map. */
-                map[std::move(default_key)] = default_value;
-                return ResultSuccess();
+                return map.Insert(key, default_value);
             }));
 
             return ResultSuccess();
@@ -681,9 +840,6 @@ namespace ams::settings::impl {
             AMS_ASSERT(key_buffer != nullptr);
             ON_SCOPE_EXIT { FreeToHeap(key_buffer, key_size); };
 
-            /* Ensure there is sufficient memory for two keys. */
-            R_UNLESS(GetHeapAllocatableSize() >= MapKeyBufferSize, settings::ResultSettingsItemKeyAllocationFailed());
-
             const MapKey key(static_cast<const char *>(key_buffer), key_size - 1);
 
             /* Read the type from the data. */
@@ -731,6 +887,9 @@ namespace ams::settings::impl {
 
             /* Load the current values for the system save data. */
             R_TRY(LoadKeyValueStoreMapCurrent(out, *system_save_data));
+
+            /* The set of keys is now fixed, so release any unused entry capacity. */
+            out->ShrinkToFit();
             return ResultSuccess();
         }
 
@@ -1029,14 +1188,12 @@ namespace ams::settings::impl {
         R_TRY(GetKeyValueStoreMap(std::addressof(map)));
         AMS_ASSERT(map != nullptr);
 
-        /* Ensure there is sufficient memory for two keys. */
-        R_UNLESS(GetHeapAllocatableSize() >= MapKeyBufferSize, settings::ResultSettingsItemKeyAllocationFailed());
-
         /* Create a map key from the key value store's name. */
-        MapKey map_key_header(m_name.value);
+        MapKeyBuffer map_key_header_buffer(m_name.value);
 
         /* Append the settings name separator. */
-        map_key_header.Append(SettingsNameSeparator);
+        map_key_header_buffer.Append(SettingsNameSeparator);
+        const MapKey map_key_header = map_key_header_buffer;
 
         /* Define the item map key. */
         const MapKey *item_map_key = nullptr;
@@ -1088,9 +1245,6 @@ namespace ams::settings::impl {
         R_TRY(GetKeyValueStoreMap(std::addressof(map)));
         AMS_ASSERT(map != nullptr);
 
-        /* Ensure there is sufficient memory for two keys. */
-        R_UNLESS(GetHeapAllocatableSize() >= MapKeyBufferSize, settings::ResultSettingsItemKeyAllocationFailed());
-
         /* Find the key in the map. */
         const Map::const_iterator it = map->find(MakeMapKey(m_name, item_key));
         R_UNLESS(it != map->end(), settings::ResultSettingsItemNotFound());
@@ -1124,9 +1278,6 @@ namespace ams::settings::impl {
         R_TRY(GetKeyValueStoreMap(std::addressof(map)));
         AMS_ASSERT(map != nullptr);
 
-        /* Ensure there is sufficient memory for two keys. */
-        R_UNLESS(GetHeapAllocatableSize() >= MapKeyBufferSize, settings::ResultSettingsItemKeyAllocationFailed());
-
         /* Find the key in the map. */
         const Map::const_iterator it = map->find(MakeMapKey(m_name, item_key));
         R_UNLESS(it != map->end(), settings::ResultSettingsItemNotFound());
@@ -1145,9 +1296,6 @@ namespace ams::settings::impl {
         R_TRY(GetKeyValueStoreMap(std::addressof(map)));
         AMS_ASSERT(map != nullptr);
 
-        /* Ensure there is sufficient memory for two keys. */
-        R_UNLESS(GetHeapAllocatableSize() >= MapKeyBufferSize, settings::ResultSettingsItemKeyAllocationFailed());
-
         /* Find the key in the map. */
         const Map::iterator it = map->find(MakeMapKey(m_name, item_key));
         R_UNLESS(it != map->end(), settings::ResultSettingsItemNotFound());
@@ -1197,9 +1345,6 @@ namespace ams::settings::impl {
         R_TRY(GetKeyValueStoreMap(std::addressof(map)));
         AMS_ASSERT(map != nullptr);
 
-        /* Ensure there is sufficient memory for two keys. */
-        R_UNLESS(GetHeapAllocatableSize() >= MapKeyBufferSize, settings::ResultSettingsItemKeyAllocationFailed());
-
         /* Find the key in the map. */
         const Map::iterator it = map->find(MakeMapKey(m_name, item_key));
         R_UNLESS(it != map->end(), settings::ResultSettingsItemNotFound());
@@ -1277,26 +1422,8 @@ namespace ams::settings::impl {
             /* Get the map value for the item. */
             R_TRY(GetMapValueOfKeyValueStoreItemForDebug(std::addressof(map_value), item));
 
-            /* Ensure there is sufficient memory for two keys. */
-            R_UNLESS(GetHeapAllocatableSize() >= MapKeyBufferSize, settings::ResultSettingsItemKeyAllocationFailed());
-
-            /* Create the map key. */
-            MapKey map_key(item.key);
-
-            /* Replace the existing value in the map if it already exists. */
-            if (const Map::iterator it = map->find(map_key); it != map->end()) {
-                /* Free the existing map value. */
-                FreeMapValueToHeap(it->second);
-
-                /* Replace the existing map value. */
-                it->second = map_value;
-            } else {
-                /* Ensure there is sufficient memory for the value. */
-                R_UNLESS(GetHeapAllocatableSize() >= MapEntryBufferSize, settings::ResultSettingsItemValueAllocationFailed());
-
-                /* Assign the map value to the map key in the map. */
-                (*map)[std::move(map_key)] = map_value;
-            }
+            /* Insert the map value into the map, replacing the existing value if it already exists. */
+            R_TRY(map->Insert(MapKey(item.key), map_value));
 
             /* Ensure we don't free the value buffers we added. */
             map_value.current_value = nullptr;
@@ -1321,9 +1448,6 @@ namespace ams::settings::impl {
         R_TRY(GetKeyValueStoreMap(std::addressof(map)));
         AMS_ASSERT(map != nullptr);
 
-        /* Ensure there is sufficient memory for two keys. */
-        R_UNLESS(GetHeapAllocatableSize() >= MapKeyBufferSize, settings::ResultSettingsItemKeyAllocationFailed());
-
         /* Locate the iterator's current key. */
         Map::const_iterator it = map->find(MapKey(out->map_key, static_cast<s32>(out->entire_size) - 1));
         R_UNLESS(it != map->end(), settings::ResultNotFoundSettingsItemKeyIterator());
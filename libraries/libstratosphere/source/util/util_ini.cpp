@@ -24,86 +24,93 @@ namespace ams::util::ini {
 
     namespace {
 
-        struct FileContext {
-            fs::FileHandle file;
-            s64 offset;
-            s64 num_left;
-
-            explicit FileContext(fs::FileHandle f) : file(f), offset(0) {
-                R_ABORT_UNLESS(fs::GetFileSize(std::addressof(this->num_left), this->file));
-            }
-        };
-
-        struct IFileContext {
-            fs::fsa::IFile *file;
-            s64 offset;
-            s64 num_left;
-
-            explicit IFileContext(fs::fsa::IFile *f) : file(f), offset(0) {
-                R_ABORT_UNLESS(file->GetSize(std::addressof(this->num_left)));
-            }
-        };
-
-        char *ini_reader_file_handle(char *str, int num, void *stream) {
-            FileContext *ctx = static_cast<FileContext *>(stream);
-
-            if (ctx->num_left == 0 || num < 2) {
-                return nullptr;
-            }
-
-            /* Read as many bytes as we can. */
-            s64 cur_read = std::min<s64>(num - 1, ctx->num_left);
-            R_ABORT_UNLESS(fs::ReadFile(ctx->file, ctx->offset, str, cur_read, fs::ReadOption()));
-
-            /* Only "read" up to the first \n. */
-            size_t offset = cur_read;
-            for (auto i = 0; i < cur_read; i++) {
-                if (str[i] == '\n') {
-                    offset = i + 1;
-                    break;
+        /* NOTE: Reading a whole window at a time means parsing costs one file read per window, rather than one per line. */
+        /* The window is shared (rather than placed on the stack), as parsing may happen on threads with small stacks. */
+        constexpr size_t ReadWindowSize = 4_KB;
+
+        constinit os::SdkMutex g_read_window_mutex;
+        constinit char g_read_window[ReadWindowSize];
+
+        template<typename ReadFunction>
+        class BufferedReader {
+            NON_COPYABLE(BufferedReader);
+            NON_MOVEABLE(BufferedReader);
+            private:
+                ReadFunction m_read;
+                s64 m_offset;
+                s64 m_num_left;
+                size_t m_window_offset;
+                size_t m_window_size;
+            public:
+                BufferedReader(ReadFunction read, s64 size) : m_read(read), m_offset(0), m_num_left(size), m_window_offset(0), m_window_size(0) { /* ... */ }
+
+                char *ReadLine(char *str, int num) {
+                    if (num < 2) {
+                        return nullptr;
+                    }
+
+                    /* Copy up to the first \n, or until the line buffer is full. */
+                    const size_t max_size = static_cast<size_t>(num - 1);
+                    size_t size = 0;
+                    while (size < max_size) {
+                        /* Ensure we have data to copy. */
+                        if (m_window_offset == m_window_size && !this->FillWindow()) {
+                            break;
+                        }
+
+                        const char *src    = g_read_window + m_window_offset;
+                        const size_t avail = std::min(m_window_size - m_window_offset, max_size - size);
+
+                        const char *newline  = static_cast<const char *>(std::memchr(src, '\n', avail));
+                        const size_t cur_size = newline != nullptr ? static_cast<size_t>(newline - src) + 1 : avail;
+
+                        std::memcpy(str + size, src, cur_size);
+                        size            += cur_size;
+                        m_window_offset += cur_size;
+
+                        if (newline != nullptr) {
+                            break;
+                        }
+                    }
+
+                    /* If there was nothing left to read, we're done. */
+                    if (size == 0) {
+                        return nullptr;
+                    }
+
+                    /* Ensure null termination. */
+                    str[size] = '\0';
+                    return str;
                 }
-            }
-
-            /* Ensure null termination. */
-            str[offset] = '\0';
-
-            /* Update context. */
-            ctx->offset   += offset;
-            ctx->num_left -= offset;
 
-            return str;
-        }
-
-        char *ini_reader_ifile(char *str, int num, void *stream) {
-            IFileContext *ctx = static_cast<IFileContext *>(stream);
-
-            if (ctx->num_left == 0 || num < 2) {
-                return nullptr;
-            }
-
-            /* Read as many bytes as we can. */
-            s64 cur_read = std::min<s64>(num - 1, ctx->num_left);
-            size_t read;
-            R_ABORT_UNLESS(ctx->file->Read(std::addressof(read), ctx->offset, str, cur_read, fs::ReadOption()));
-            AMS_ABORT_UNLESS(static_cast<s64>(read) == cur_read);
-
-            /* Only "read" up to the first \n. */
-            size_t offset = cur_read;
-            for (auto i = 0; i < cur_read; i++) {
-                if (str[i] == '\n') {
-                    offset = i + 1;
-                    break;
+                static char *ReadLine(char *str, int num, void *stream) {
+                    return static_cast<BufferedReader *>(stream)->ReadLine(str, num);
                 }
-            }
-
-            /* Ensure null termination. */
-            str[offset] = '\0';
+            private:
+                bool FillWindow() {
+                    if (m_num_left == 0) {
+                        return false;
+                    }
+
+                    /* Read as many bytes as we can. */
+                    const size_t cur_read = static_cast<size_t>(std::min<s64>(sizeof(g_read_window), m_num_left));
+                    m_read(g_read_window, m_offset, cur_read);
+
+                    /* Update context. */
+                    m_offset        += cur_read;
+                    m_num_left      -= cur_read;
+                    m_window_offset  = 0;
+                    m_window_size    = cur_read;
+                    return true;
+                }
+        };
 
-            /* Update context. */
-            ctx->offset   += offset;
-            ctx->num_left -= offset;
+        template<typename ReadFunction>
+        int ParseBuffered(ReadFunction read, s64 size, void *user_ctx, Handler h) {
+            std::scoped_lock lk(g_read_window_mutex);
 
-            return str;
+            BufferedReader<ReadFunction> reader(read, size);
+            return ini_parse_stream(BufferedReader<ReadFunction>::ReadLine, std::addressof(reader), h, user_ctx);
         }
 
     }
@@ -114,13 +121,25 @@ namespace ams::util::ini {
     }
 
     int ParseFile(fs::FileHandle file, void *user_ctx, Handler h) {
-        FileContext ctx(file);
-        return ini_parse_stream(ini_reader_file_handle, std::addressof(ctx), h, user_ctx);
+        s64 size;
+        R_ABORT_UNLESS(fs::GetFileSize(std::addressof(size), file));
+
+        auto read = [file](char *dst, s64 offset, size_t read_size) ALWAYS_INLINE_LAMBDA {
+            R_ABORT_UNLESS(fs::ReadFile(file, offset, dst, read_size, fs::ReadOption()));
+        };
+        return ParseBuffered(read, size, user_ctx, h);
     }
 
     int ParseFile(fs::fsa::IFile *file, void *user_ctx, Handler h) {
-        IFileContext ctx(file);
-        return ini_parse_stream(ini_reader_ifile, std::addressof(ctx), h, user_ctx);
+        s64 size;
+        R_ABORT_UNLESS(file->GetSize(std::addressof(size)));
+
+        auto read = [file](char *dst, s64 offset, size_t read_size) ALWAYS_INLINE_LAMBDA {
+            size_t size_read;
+            R_ABORT_UNLESS(file->Read(std::addressof(size_read), offset, dst, read_size, fs::ReadOption()));
+            AMS_ABORT_UNLESS(size_read == read_size);
+        };
+        return ParseBuffered(read, size, user_ctx, h);
     }
 
-}
\ No newline at end of file
+}
@@ -36,6 +36,96 @@ namespace ams::mitm::fs {
             return FormatAtmosphereSdPath(dst_path, dst_path_size, program_id, "romfs", src_path);
         }
 
+        class SdRomfsContentCache {
+            private:
+                struct Entry {
+                    ncm::ProgramId program_id;
+                    bool has_content;
+                };
+
+                static constexpr size_t EntryCount = 0x200;
+                static_assert(util::IsPowerOfTwo(EntryCount));
+            private:
+                os::SdkMutex m_mutex;
+                u64 m_generation;
+                Entry m_entries[EntryCount];
+            public:
+                constexpr SdRomfsContentCache() : m_mutex(), m_generation(0), m_entries() { /* ... */ }
+
+                bool Find(bool *out, u64 *out_generation, ncm::ProgramId program_id) {
+                    std::scoped_lock lk(m_mutex);
+
+                    /* Get the current generation, so that a result computed by the caller can be discarded if we're invalidated in the meantime. */
+                    *out_generation = m_generation;
+
+                    const Entry &entry = m_entries[GetIndex(program_id)];
+                    if (program_id == ncm::InvalidProgramId || entry.program_id != program_id) {
+                        return false;
+                    }
+
+                    *out = entry.has_content;
+                    return true;
+                }
+
+                void Insert(ncm::ProgramId program_id, bool has_content, u64 generation) {
+                    std::scoped_lock lk(m_mutex);
+
+                    /* If the cache was invalidated while the caller was checking the sd card, their result may be stale. */
+                    if (program_id == ncm::InvalidProgramId || generation != m_generation) {
+                        return;
+                    }
+
+                    m_entries[GetIndex(program_id)] = { program_id, has_content };
+                }
+
+                void Invalidate() {
+                    std::scoped_lock lk(m_mutex);
+
+                    ++m_generation;
+                    for (auto &entry : m_entries) {
+                        entry.program_id = ncm::InvalidProgramId;
+                    }
+                }
+
+                void Invalidate(ncm::ProgramId program_id) {
+                    std::scoped_lock lk(m_mutex);
+
+                    ++m_generation;
+                    if (Entry &entry = m_entries[GetIndex(program_id)]; entry.program_id == program_id) {
+                        entry.program_id = ncm::InvalidProgramId;
+                    }
+                }
+            private:
+                static constexpr ALWAYS_INLINE size_t GetIndex(ncm::ProgramId program_id) {
+                    /* NOTE: Program ids mostly differ in their middle bits, so mix them before selecting an entry. */
+                    return static_cast<size_t>((program_id.value * UINT64_C(0x9E3779B97F4A7C15)) >> 32) & (EntryCount - 1);
+                }
+        };
+
+        constinit SdRomfsContentCache g_sd_romfs_content_cache;
+
+        bool HasSdRomfsContentImpl(ncm::ProgramId program_id) {
+            /* Check if romfs.bin is present. */
+            {
+                FsFile romfs_file;
+                if (R_SUCCEEDED(OpenAtmosphereSdFile(std::addressof(romfs_file), program_id, "romfs.bin", OpenMode_Read))) {
+                    fsFileClose(std::addressof(romfs_file));
+                    return true;
+                }
+            }
+
+            /* Check for romfs folder with content. */
+            FsDir romfs_dir;
+            if (R_FAILED(OpenAtmosphereSdRomfsDirectory(std::addressof(romfs_dir), program_id, "", OpenDirectoryMode_All))) {
+                return false;
+            }
+            ON_SCOPE_EXIT { fsDirClose(std::addressof(romfs_dir)); };
+
+            /* Verify the folder has at least one entry. */
+            s64 num_entries = 0;
+            return R_SUCCEEDED(fsDirGetEntryCount(std::addressof(romfs_dir), std::addressof(num_entries))) && num_entries > 0;
+        }
+
     }
 
     void OpenGlobalSdCardFileSystem() {
@@ -185,25 +275,28 @@ namespace ams::mitm::fs {
     }
 
     bool HasSdRomfsContent(ncm::ProgramId program_id) {
-        /* Check if romfs.bin is present. */
-        {
-            FsFile romfs_file;
-            if (R_SUCCEEDED(OpenAtmosphereSdFile(std::addressof(romfs_file), program_id, "romfs.bin", OpenMode_Read))) {
-                fsFileClose(std::addressof(romfs_file));
-                return true;
-            }
+        /* Most programs never have sd content, so remember the result (positive or negative) rather than checking the sd card on every open. */
+        bool has_content;
+        u64 generation;
+        if (g_sd_romfs_content_cache.Find(std::addressof(has_content), std::addressof(generation), program_id)) {
+            return has_content;
         }
 
-        /* Check for romfs folder with content. */
-        FsDir romfs_dir;
-        if (R_FAILED(OpenAtmosphereSdRomfsDirectory(std::addressof(romfs_dir), program_id, "", OpenDirectoryMode_All))) {
-            return false;
+        /* Check the sd card, and cache the result. */
+        has_content = HasSdRomfsContentImpl(program_id);
+        if (R_SUCCEEDED(EnsureSdInitialized())) {
+            g_sd_romfs_content_cache.Insert(program_id, has_content, generation);
         }
-        ON_SCOPE_EXIT { fsDirClose(std::addressof(romfs_dir)); };
 
-        /* Verify the folder has at least one entry. */
-        s64 num_entries = 0;
-        return R_SUCCEEDED(fsDirGetEntryCount(std::addressof(romfs_dir), std::addressof(num_entries))) && num_entries > 0;
+        return has_content;
+    }
+
+    void InvalidateSdRomfsContentCache() {
+        g_sd_romfs_content_cache.Invalidate();
+    }
+
+    void InvalidateSdRomfsContentCache(ncm::ProgramId program_id) {
+        g_sd_romfs_content_cache.Invalidate(program_id);
     }
 
     Result SaveAtmosphereSdFile(FsFile *out, ncm::ProgramId program_id, const char *path, void *data, size_t size) {
@@ -48,6 +48,8 @@ namespace ams::mitm::fs {
     void FormatAtmosphereSdPath(char *dst_path, size_t dst_path_size, ncm::ProgramId program_id, const char *subdir, const char *src_path);
 
     bool HasSdRomfsContent(ncm::ProgramId program_id);
+    void InvalidateSdRomfsContentCache();
+    void InvalidateSdRomfsContentCache(ncm::ProgramId program_id);
 
     Result SaveAtmosphereSdFile(FsFile *out, ncm::ProgramId program_id, const char *path, void *data, size_t size);
     Result CreateAndOpenAtmosphereSdFile(FsFile *out, ncm::ProgramId program_id, const char *path, size_t size);
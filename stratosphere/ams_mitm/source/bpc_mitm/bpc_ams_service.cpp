@@ -15,6 +15,7 @@
  */
 #include <stratosphere.hpp>
 #include "../amsmitm_initialization.hpp"
+#include "../amsmitm_fs_utils.hpp"
 #include "bpc_ams_service.hpp"
 #include "bpc_ams_power_utils.hpp"
 
@@ -44,4 +45,8 @@ namespace ams::mitm::bpc {
         }
     }
 
+    void AtmosphereService::InvalidateSdRomfsContentCache() {
+        mitm::fs::InvalidateSdRomfsContentCache();
+    }
+
 }
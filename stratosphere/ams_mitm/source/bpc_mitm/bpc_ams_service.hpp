@@ -16,9 +16,10 @@
 #pragma once
 #include <stratosphere.hpp>
 
-#define AMS_BPC_MITM_ATMOSPHERE_INTERFACE_INTERFACE_INFO(C, H)                                                \
-    AMS_SF_METHOD_INFO(C, H, 65000, void, RebootToFatalError, (const ams::FatalErrorContext &ctx), (ctx))     \
-    AMS_SF_METHOD_INFO(C, H, 65001, void, SetRebootPayload,   (const ams::sf::InBuffer &payload),  (payload))
+#define AMS_BPC_MITM_ATMOSPHERE_INTERFACE_INTERFACE_INFO(C, H)                                                                    \
+    AMS_SF_METHOD_INFO(C, H, 65000, void, RebootToFatalError,            (const ams::FatalErrorContext &ctx), (ctx))     \
+    AMS_SF_METHOD_INFO(C, H, 65001, void, SetRebootPayload,              (const ams::sf::InBuffer &payload),  (payload)) \
+    AMS_SF_METHOD_INFO(C, H, 65002, void, InvalidateSdRomfsContentCache, (),                                  ())
 
 AMS_SF_DEFINE_INTERFACE(ams::mitm::bpc::impl, IAtmosphereInterface, AMS_BPC_MITM_ATMOSPHERE_INTERFACE_INTERFACE_INFO)
 
@@ -28,6 +29,7 @@ namespace ams::mitm::bpc {
         public:
             void RebootToFatalError(const ams::FatalErrorContext &ctx);
             void SetRebootPayload(const ams::sf::InBuffer &payload);
+            void InvalidateSdRomfsContentCache();
     };
     static_assert(impl::IsIAtmosphereInterface<AtmosphereService>);
 
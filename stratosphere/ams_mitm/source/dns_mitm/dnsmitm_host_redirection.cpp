@@ -68,185 +68,326 @@ namespace ams::mitm::socket::resolver {
             "# Nintendo telemetry servers\n"
             "127.0.0.1 receive-%.dg.srv.nintendo.net receive-%.er.srv.nintendo.net\n";
 
-        constinit os::SdkMutex g_redirection_lock;
-        std::vector<std::pair<std::string, ams::socket::InAddrT>> g_redirection_list;
+        constexpr inline u32 InitialHostHash = 0x811C9DC5;
 
-        void RemoveRedirection(const char *hostname) {
-            for (auto it = g_redirection_list.begin(); it != g_redirection_list.end(); ++it) {
-                if (std::strcmp(it->first.c_str(), hostname) == 0) {
-                    g_redirection_list.erase(it);
-                    break;
-                }
+        constexpr ALWAYS_INLINE u32 UpdateHostHash(u32 hash, char c) {
+            return (hash ^ static_cast<u8>(c)) * 0x01000193;
+        }
+
+        constexpr u32 GetHostHash(const char *name, size_t size) {
+            /* NOTE: Names are hashed back-to-front, so that the hashes of all suffixes of a hostname can be computed in a single pass. */
+            u32 hash = InitialHostHash;
+            for (size_t i = size; i > 0; --i) {
+                hash = UpdateHostHash(hash, name[i - 1]);
             }
+            return hash;
+        }
+
+        class RedirectionTable {
+            public:
+                struct Entry {
+                    u32 name_offset;
+                    u32 name_size;
+                    u32 hash;
+                    u32 order;
+                    ams::socket::InAddrT address;
+                };
+            private:
+                static constexpr size_t MinimumBucketCount = 0x100;
+            private:
+                std::vector<char> m_names;
+                std::vector<Entry> m_entries;
+                std::vector<u32> m_buckets;
+            public:
+                void Clear() {
+                    /* Release all memory, as tables may be very large. */
+                    std::vector<char>().swap(m_names);
+                    std::vector<Entry>().swap(m_entries);
+                    std::vector<u32>().swap(m_buckets);
+                }
+
+                size_t GetCount() const { return m_entries.size(); }
+
+                const char *GetName(const Entry &entry) const { return m_names.data() + entry.name_offset; }
+
+                const Entry *Find(const char *name, size_t size, u32 hash) const {
+                    /* If we have no entries, we can't find anything. */
+                    if (m_buckets.empty()) {
+                        return nullptr;
+                    }
+
+                    /* Probe for the entry. */
+                    const size_t mask = m_buckets.size() - 1;
+                    for (size_t i = hash & mask; m_buckets[i] != 0; i = (i + 1) & mask) {
+                        const Entry &entry = m_entries[m_buckets[i] - 1];
+                        if (entry.hash == hash && entry.name_size == size && std::memcmp(this->GetName(entry), name, size) == 0) {
+                            return std::addressof(entry);
+                        }
+                    }
+
+                    return nullptr;
+                }
+
+                void Insert(const char *name, size_t size, u32 hash, ams::socket::InAddrT address, u32 order) {
+                    /* If we already have an entry for the name, the newer redirection replaces it. */
+                    if (const Entry *found = this->Find(name, size, hash); found != nullptr) {
+                        Entry &entry  = m_entries[found - m_entries.data()];
+                        entry.address = address;
+                        entry.order   = order;
+                        return;
+                    }
+
+                    /* Ensure we have space for the new entry, keeping the table at most half full. */
+                    if (2 * (m_entries.size() + 1) > m_buckets.size()) {
+                        this->Rehash(std::max(MinimumBucketCount, 2 * m_buckets.size()));
+                    }
+
+                    /* Add the name. */
+                    const size_t name_offset = m_names.size();
+                    m_names.insert(m_names.end(), name, name + size);
+                    m_names.push_back('\x00');
+
+                    /* Add the entry. */
+                    m_entries.push_back(Entry{ static_cast<u32>(name_offset), static_cast<u32>(size), hash, order, address });
+                    this->Link(m_entries.size() - 1);
+                }
+
+                template<typename F>
+                void ForEach(F f) const {
+                    for (const auto &entry : m_entries) {
+                        f(entry);
+                    }
+                }
+            private:
+                void Link(size_t index) {
+                    const size_t mask = m_buckets.size() - 1;
+
+                    size_t i = m_entries[index].hash & mask;
+                    while (m_buckets[i] != 0) {
+                        i = (i + 1) & mask;
+                    }
+
+                    m_buckets[i] = index + 1;
+                }
+
+                void Rehash(size_t bucket_count) {
+                    m_buckets.assign(bucket_count, 0);
+                    for (size_t i = 0; i < m_entries.size(); ++i) {
+                        this->Link(i);
+                    }
+                }
+        };
+
+        constinit os::SdkMutex g_redirection_lock;
+        constinit u32 g_redirection_order = 0;
+
+        /* NOTE: Redirections are split by pattern kind, so that lookups don't need to compare against every pattern. */
+        /* Exact hostnames are keyed by name, patterns of the form "*suffix" are keyed by suffix, and all other patterns are checked one by one. */
+        RedirectionTable g_exact_redirections;
+        RedirectionTable g_suffix_redirections;
+        RedirectionTable g_pattern_redirections;
+
+        void ClearRedirections() {
+            g_exact_redirections.Clear();
+            g_suffix_redirections.Clear();
+            g_pattern_redirections.Clear();
+            g_redirection_order = 0;
+        }
+
+        size_t GetRedirectionCount() {
+            return g_exact_redirections.GetCount() + g_suffix_redirections.GetCount() + g_pattern_redirections.GetCount();
         }
 
         void AddRedirection(const char *hostname, ams::socket::InAddrT addr) {
-            RemoveRedirection(hostname);
-            g_redirection_list.emplace(g_redirection_list.begin(), std::string(hostname), addr);
+            /* NOTE: When several redirections match a hostname, the one added last wins. */
+            const u32 order = g_redirection_order++;
+            const size_t len = std::strlen(hostname);
+
+            if (const char *wildcard = std::strchr(hostname, '*'); wildcard == nullptr) {
+                g_exact_redirections.Insert(hostname, len, GetHostHash(hostname, len), addr, order);
+            } else if (wildcard == hostname && std::strchr(wildcard + 1, '*') == nullptr) {
+                g_suffix_redirections.Insert(hostname + 1, len - 1, GetHostHash(hostname + 1, len - 1), addr, order);
+            } else {
+                g_pattern_redirections.Insert(hostname, len, GetHostHash(hostname, len), addr, order);
+            }
         }
 
         constinit char g_specific_emummc_hosts_path[0x40] = {};
 
-        void ParseHostsFile(const char *file_data) {
-            /* Get the environment identifier from settings. */
-            const auto env     = ams::nsd::impl::device::GetEnvironmentIdentifierFromSettings();
-            const auto env_len = std::strlen(env.value);
-
-            /* Parse the file. */
-            enum class State {
-                IgnoredLine,
-                BeginLine,
-                Ip1,
-                IpDot1,
-                Ip2,
-                IpDot2,
-                Ip3,
-                IpDot3,
-                Ip4,
-                WhiteSpace,
-                HostName,
-            };
-
-            ams::socket::InAddrT current_address;
-            char current_hostname[0x200];
-            u32 work;
-
-            State state = State::BeginLine;
-            for (const char *cur = file_data; *cur != '\x00'; ++cur) {
-                const char c = *cur;
-                switch (state) {
-                    case State::IgnoredLine:
-                        if (c == '\n') {
-                            state = State::BeginLine;
-                        }
-                        break;
-                    case State::BeginLine:
-                        if (std::isdigit(static_cast<unsigned char>(c))) {
-                            current_address = 0;
-                            work            = static_cast<u32>(c - '0');
-                            state           = State::Ip1;
-                        } else if (c == '\n') {
-                            state = State::BeginLine;
-                        } else {
-                            state = State::IgnoredLine;
-                        }
-                        break;
-                    case State::Ip1:
-                        if (std::isdigit(static_cast<unsigned char>(c))) {
-                            work *= 10;
-                            work += static_cast<u32>(c - '0');
-                        } else if (c == '.') {
-                            current_address |= (work & 0xFF) << 0;
-                            work = 0;
-                            state = State::IpDot1;
-                        } else {
-                            state = State::IgnoredLine;
-                        }
-                        break;
-                    case State::IpDot1:
-                        if (std::isdigit(static_cast<unsigned char>(c))) {
-                            work            = static_cast<u32>(c - '0');
-                            state           = State::Ip2;
-                        } else {
-                            state = State::IgnoredLine;
-                        }
-                        break;
-                    case State::Ip2:
-                        if (std::isdigit(static_cast<unsigned char>(c))) {
-                            work *= 10;
-                            work += static_cast<u32>(c - '0');
-                        } else if (c == '.') {
-                            current_address |= (work & 0xFF) << 8;
-                            work = 0;
-                            state = State::IpDot2;
-                        } else {
-                            state = State::IgnoredLine;
-                        }
-                        break;
-                    case State::IpDot2:
-                        if (std::isdigit(static_cast<unsigned char>(c))) {
-                            work            = static_cast<u32>(c - '0');
-                            state           = State::Ip3;
-                        } else {
-                            state = State::IgnoredLine;
-                        }
-                        break;
-                    case State::Ip3:
-                        if (std::isdigit(static_cast<unsigned char>(c))) {
-                            work *= 10;
-                            work += static_cast<u32>(c - '0');
-                        } else if (c == '.') {
-                            current_address |= (work & 0xFF) << 16;
-                            work = 0;
-                            state = State::IpDot3;
-                        } else {
-                            state = State::IgnoredLine;
-                        }
-                        break;
-                    case State::IpDot3:
-                        if (std::isdigit(static_cast<unsigned char>(c))) {
-                            work            = static_cast<u32>(c - '0');
-                            state           = State::Ip4;
-                        } else {
-                            state = State::IgnoredLine;
-                        }
-                        break;
-                    case State::Ip4:
-                        if (std::isdigit(static_cast<unsigned char>(c))) {
-                            work *= 10;
-                            work += static_cast<u32>(c - '0');
-                        } else if (c == ' ' || c == '\t') {
-                            current_address |= (work & 0xFF) << 24;
-                            work = 0;
-                            state = State::WhiteSpace;
-                        } else {
-                            state = State::IgnoredLine;
-                        }
-                        break;
-                    case State::WhiteSpace:
-                        if (c == '\n') {
-                            state = State::BeginLine;
-                        } else if (c != ' ' && c != '\r' && c != '\t') {
-                            if (c == '%') {
-                                std::memcpy(current_hostname, env.value, env_len);
-                                work = env_len;
-                            } else {
-                                current_hostname[0] = c;
-                                work = 1;
-                            }
-                            state = State::HostName;
-                        }
-                        break;
-                    case State::HostName:
-                        if (c == ' ' || c == '\r' || c == '\n' || c == '\t') {
-                            AMS_ABORT_UNLESS(work < sizeof(current_hostname));
-                            current_hostname[work] = '\x00';
-
-                            AddRedirection(current_hostname, current_address);
-                            work = 0;
-
-                            if (c == '\n') {
-                                state = State::BeginLine;
-                            } else {
-                                state = State::WhiteSpace;
-                            }
-                        } else if (c == '%') {
-                            AMS_ABORT_UNLESS(work < sizeof(current_hostname) - env_len);
-                            std::memcpy(current_hostname + work, env.value, env_len);
-                            work += env_len;
-                        } else {
-                            AMS_ABORT_UNLESS(work < sizeof(current_hostname) - 1);
-                            current_hostname[work++] = c;
+        class HostsFileParser {
+            private:
+                enum class State {
+                    IgnoredLine,
+                    BeginLine,
+                    Ip1,
+                    IpDot1,
+                    Ip2,
+                    IpDot2,
+                    Ip3,
+                    IpDot3,
+                    Ip4,
+                    WhiteSpace,
+                    HostName,
+                };
+            private:
+                ams::nsd::EnvironmentIdentifier m_env;
+                size_t m_env_len;
+                State m_state;
+                ams::socket::InAddrT m_current_address;
+                char m_current_hostname[0x200];
+                u32 m_work;
+            public:
+                HostsFileParser() : m_env(ams::nsd::impl::device::GetEnvironmentIdentifierFromSettings()), m_env_len(std::strlen(m_env.value)), m_state(State::BeginLine), m_current_address(0), m_work(0) {
+                    /* ... */
+                }
+
+                void Parse(const char *data, size_t size) {
+                    for (const char *cur = data; cur != data + size; ++cur) {
+                        const char c = *cur;
+                        switch (m_state) {
+                            case State::IgnoredLine:
+                                if (c == '\n') {
+                                    m_state = State::BeginLine;
+                                }
+                                break;
+                            case State::BeginLine:
+                                if (std::isdigit(static_cast<unsigned char>(c))) {
+                                    m_current_address = 0;
+                                    m_work            = static_cast<u32>(c - '0');
+                                    m_state           = State::Ip1;
+                                } else if (c == '\n') {
+                                    m_state = State::BeginLine;
+                                } else {
+                                    m_state = State::IgnoredLine;
+                                }
+                                break;
+                            case State::Ip1:
+                                if (std::isdigit(static_cast<unsigned char>(c))) {
+                                    m_work *= 10;
+                                    m_work += static_cast<u32>(c - '0');
+                                } else if (c == '.') {
+                                    m_current_address |= (m_work & 0xFF) << 0;
+                                    m_work = 0;
+                                    m_state = State::IpDot1;
+                                } else {
+                                    m_state = State::IgnoredLine;
+                                }
+                                break;
+                            case State::IpDot1:
+                                if (std::isdigit(static_cast<unsigned char>(c))) {
+                                    m_work            = static_cast<u32>(c - '0');
+                                    m_state           = State::Ip2;
+                                } else {
+                                    m_state = State::IgnoredLine;
+                                }
+                                break;
+                            case State::Ip2:
+                                if (std::isdigit(static_cast<unsigned char>(c))) {
+                                    m_work *= 10;
+                                    m_work += static_cast<u32>(c - '0');
+                                } else if (c == '.') {
+                                    m_current_address |= (m_work & 0xFF) << 8;
+                                    m_work = 0;
+                                    m_state = State::IpDot2;
+                                } else {
+                                    m_state = State::IgnoredLine;
+                                }
+                                break;
+                            case State::IpDot2:
+                                if (std::isdigit(static_cast<unsigned char>(c))) {
+                                    m_work            = static_cast<u32>(c - '0');
+                                    m_state           = State::Ip3;
+                                } else {
+                                    m_state = State::IgnoredLine;
+                                }
+                                break;
+                            case State::Ip3:
+                                if (std::isdigit(static_cast<unsigned char>(c))) {
+                                    m_work *= 10;
+                                    m_work += static_cast<u32>(c - '0');
+                                } else if (c == '.') {
+                                    m_current_address |= (m_work & 0xFF) << 16;
+                                    m_work = 0;
+                                    m_state = State::IpDot3;
+                                } else {
+                                    m_state = State::IgnoredLine;
+                                }
+                                break;
+                            case State::IpDot3:
+                                if (std::isdigit(static_cast<unsigned char>(c))) {
+                                    m_work            = static_cast<u32>(c - '0');
+                                    m_state           = State::Ip4;
+                                } else {
+                                    m_state = State::IgnoredLine;
+                                }
+                                break;
+                            case State::Ip4:
+                                if (std::isdigit(static_cast<unsigned char>(c))) {
+                                    m_work *= 10;
+                                    m_work += static_cast<u32>(c - '0');
+                                } else if (c == ' ' || c == '\t') {
+                                    m_current_address |= (m_work & 0xFF) << 24;
+                                    m_work = 0;
+                                    m_state = State::WhiteSpace;
+                                } else {
+                                    m_state = State::IgnoredLine;
+                                }
+                                break;
+                            case State::WhiteSpace:
+                                if (c == '\n') {
+                                    m_state = State::BeginLine;
+                                } else if (c != ' ' && c != '\r' && c != '\t') {
+                                    if (c == '%') {
+                                        std::memcpy(m_current_hostname, m_env.value, m_env_len);
+                                        m_work = m_env_len;
+                                    } else {
+                                        m_current_hostname[0] = c;
+                                        m_work = 1;
+                                    }
+                                    m_state = State::HostName;
+                                }
+                                break;
+                            case State::HostName:
+                                if (c == ' ' || c == '\r' || c == '\n' || c == '\t') {
+                                    AMS_ABORT_UNLESS(m_work < sizeof(m_current_hostname));
+                                    m_current_hostname[m_work] = '\x00';
+
+                                    AddRedirection(m_current_hostname, m_current_address);
+                                    m_work = 0;
+
+                                    if (c == '\n') {
+                                        m_state = State::BeginLine;
+                                    } else {
+                                        m_state = State::WhiteSpace;
+                                    }
+                                } else if (c == '%') {
+                                    AMS_ABORT_UNLESS(m_work < sizeof(m_current_hostname) - m_env_len);
+                                    std::memcpy(m_current_hostname + m_work, m_env.value, m_env_len);
+                                    m_work += m_env_len;
+                                } else {
+                                    AMS_ABORT_UNLESS(m_work < sizeof(m_current_hostname) - 1);
+                                    m_current_hostname[m_work++] = c;
+                                }
                         }
+                    }
                 }
-            }
 
-            if (state == State::HostName) {
-                AMS_ABORT_UNLESS(work < sizeof(current_hostname));
-                current_hostname[work] = '\x00';
+                void Finalize() {
+                    if (m_state == State::HostName) {
+                        AMS_ABORT_UNLESS(m_work < sizeof(m_current_hostname));
+                        m_current_hostname[m_work] = '\x00';
 
-                AddRedirection(current_hostname, current_address);
-            }
+                        AddRedirection(m_current_hostname, m_current_address);
+                    }
+
+                    m_state = State::BeginLine;
+                }
+        };
+
+        void ParseHostsFile(const char *file_data) {
+            HostsFileParser parser;
+            parser.Parse(file_data, std::strlen(file_data));
+            parser.Finalize();
         }
 
         void Log(::FsFile &f, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
@@ -308,8 +449,8 @@ namespace ams::mitm::socket::resolver {
         /* Acquire exclusive access to the map. */
         std::scoped_lock lk(g_redirection_lock);
 
-        /* Clear the redirections map. */
-        g_redirection_list.clear();
+        /* Clear the redirections. */
+        ClearRedirections();
 
         /* Open log file. */
         ::FsFile log_file;
@@ -346,54 +487,108 @@ namespace ams::mitm::socket::resolver {
 
         /* Load the hosts file. */
         {
-            char *hosts_file_data = nullptr;
-            ON_SCOPE_EXIT { if (hosts_file_data != nullptr) { ams::Free(hosts_file_data); } };
-            {
-                ::FsFile hosts_file;
-                R_ABORT_UNLESS(mitm::fs::OpenAtmosphereSdFile(std::addressof(hosts_file), hosts_path, ams::fs::OpenMode_Read));
-                ON_SCOPE_EXIT { ::fsFileClose(std::addressof(hosts_file)); };
+            /* NOTE: Hosts files (e.g. block lists) may be very large, so we parse them as we read them. */
+            constexpr size_t HostsFileBufferSize = 0x4000;
+            char *hosts_file_buffer = static_cast<char *>(ams::Malloc(HostsFileBufferSize));
+            AMS_ABORT_UNLESS(hosts_file_buffer != nullptr);
+            ON_SCOPE_EXIT { ams::Free(hosts_file_buffer); };
 
-                /* Get the hosts file size. */
-                s64 hosts_size;
-                R_ABORT_UNLESS(::fsFileGetSize(std::addressof(hosts_file), std::addressof(hosts_size)));
+            ::FsFile hosts_file;
+            R_ABORT_UNLESS(mitm::fs::OpenAtmosphereSdFile(std::addressof(hosts_file), hosts_path, ams::fs::OpenMode_Read));
+            ON_SCOPE_EXIT { ::fsFileClose(std::addressof(hosts_file)); };
 
-                /* Validate we can read the file. */
-                AMS_ABORT_UNLESS(0 <= hosts_size && hosts_size < 0x8000);
+            /* Get the hosts file size. */
+            s64 hosts_size;
+            R_ABORT_UNLESS(::fsFileGetSize(std::addressof(hosts_file), std::addressof(hosts_size)));
+            AMS_ABORT_UNLESS(0 <= hosts_size);
 
-                /* Read the data. */
-                hosts_file_data = static_cast<char *>(ams::Malloc(0x8000));
-                AMS_ABORT_UNLESS(hosts_file_data != nullptr);
+            /* Parse the hosts file. */
+            HostsFileParser parser;
+            for (s64 offset = 0; offset < hosts_size; /* ... */) {
+                const size_t cur_size = static_cast<size_t>(std::min<s64>(hosts_size - offset, HostsFileBufferSize));
 
                 u64 br;
-                R_ABORT_UNLESS(::fsFileRead(std::addressof(hosts_file), 0, hosts_file_data, hosts_size, ::FsReadOption_None, std::addressof(br)));
-                AMS_ABORT_UNLESS(br == static_cast<u64>(hosts_size));
+                R_ABORT_UNLESS(::fsFileRead(std::addressof(hosts_file), offset, hosts_file_buffer, cur_size, ::FsReadOption_None, std::addressof(br)));
+                AMS_ABORT_UNLESS(br == cur_size);
 
-                /* Null-terminate. */
-                hosts_file_data[hosts_size] = '\x00';
+                parser.Parse(hosts_file_buffer, cur_size);
+                offset += cur_size;
             }
-
-            /* Parse the hosts file. */
-            ParseHostsFile(hosts_file_data);
+            parser.Finalize();
         }
 
-        /* Print the redirections. */
-        Log(log_file, "Redirections:\n");
-        for (const auto &[host, address] : g_redirection_list) {
-            Log(log_file, "    `%s` -> %u.%u.%u.%u\n", host.c_str(), (address >> 0) & 0xFF, (address >> 8) & 0xFF, (address >> 16) & 0xFF, (address >> 24) & 0xFF);
+        /* Print the redirections, if there aren't too many to reasonably log. */
+        const size_t redirection_count = GetRedirectionCount();
+        Log(log_file, "Redirections: %zu\n", redirection_count);
+
+        constexpr size_t MaxLoggedRedirectionCount = 0x100;
+        if (redirection_count <= MaxLoggedRedirectionCount) {
+            /* Print them, newest (and therefore highest priority) first. */
+            u32 order_limit = g_redirection_order;
+            for (size_t i = 0; i < redirection_count; ++i) {
+                /* Find the newest redirection older than the last one we printed. */
+                const RedirectionTable::Entry *newest = nullptr;
+                const char *prefix = "";
+                const char *host   = nullptr;
+                auto FindNewest = [&](const RedirectionTable &table, const char *table_prefix) ALWAYS_INLINE_LAMBDA {
+                    table.ForEach([&](const RedirectionTable::Entry &entry) ALWAYS_INLINE_LAMBDA {
+                        if (entry.order < order_limit && (newest == nullptr || entry.order > newest->order)) {
+                            newest = std::addressof(entry);
+                            prefix = table_prefix;
+                            host   = table.GetName(entry);
+                        }
+                    });
+                };
+
+                FindNewest(g_exact_redirections, "");
+                FindNewest(g_suffix_redirections, "*");
+                FindNewest(g_pattern_redirections, "");
+                AMS_ABORT_UNLESS(newest != nullptr);
+
+                const auto address = newest->address;
+                Log(log_file, "    `%s%s` -> %u.%u.%u.%u\n", prefix, host, (address >> 0) & 0xFF, (address >> 8) & 0xFF, (address >> 16) & 0xFF, (address >> 24) & 0xFF);
+
+                order_limit = newest->order;
+            }
         }
     }
 
     bool GetRedirectedHostByName(ams::socket::InAddrT *out, const char *hostname) {
         std::scoped_lock lk(g_redirection_lock);
 
-        for (const auto &[host, address] : g_redirection_list) {
-            if (wildcardcmp(host.c_str(), hostname)) {
-                *out = address;
-                return true;
+        /* Find the newest redirection which matches the hostname. */
+        const RedirectionTable::Entry *match = nullptr;
+        auto UpdateMatch = [&](const RedirectionTable::Entry *entry) ALWAYS_INLINE_LAMBDA {
+            if (entry != nullptr && (match == nullptr || entry->order > match->order)) {
+                match = entry;
             }
+        };
+
+        /* Check "*suffix" patterns against every suffix of the hostname, computing the suffix hashes as we go. */
+        const size_t len = std::strlen(hostname);
+        u32 hash = InitialHostHash;
+        UpdateMatch(g_suffix_redirections.Find(hostname + len, 0, hash));
+        for (size_t i = len; i > 0; --i) {
+            hash = UpdateHostHash(hash, hostname[i - 1]);
+            UpdateMatch(g_suffix_redirections.Find(hostname + i - 1, len - i + 1, hash));
+        }
+
+        /* Check for an exact match, using the hash of the full hostname. */
+        UpdateMatch(g_exact_redirections.Find(hostname, len, hash));
+
+        /* Check any other patterns. */
+        g_pattern_redirections.ForEach([&](const RedirectionTable::Entry &entry) ALWAYS_INLINE_LAMBDA {
+            if (wildcardcmp(g_pattern_redirections.GetName(entry), hostname)) {
+                UpdateMatch(std::addressof(entry));
+            }
+        });
+
+        if (match == nullptr) {
+            return false;
         }
 
-        return false;
+        *out = match->address;
+        return true;
     }
 
 }
@@ -154,6 +154,17 @@ namespace ams::mitm::fs {
 
     }
 
+    FsMitmService::FsMitmService(std::shared_ptr<::Service> &&s, const sm::MitmProcessInfo &c) : sf::MitmServiceImplBase(std::forward<std::shared_ptr<::Service>>(s), c) {
+        /* The client may have been (re-)launched because its sd content changed, so make sure we check for its content again. */
+        /* Applications also open data (e.g. add-on content) and sub-programs by id, which we can't enumerate here. */
+        /* So when an application is launched, everything is checked again. */
+        if (ncm::IsSystemProgramId(m_client_info.program_id)) {
+            mitm::fs::InvalidateSdRomfsContentCache(m_client_info.program_id);
+        } else {
+            mitm::fs::InvalidateSdRomfsContentCache();
+        }
+    }
+
     Result FsMitmService::OpenFileSystemWithPatch(sf::Out<sf::SharedPointer<ams::fssrv::sf::IFileSystem>> out, ncm::ProgramId program_id, u32 _filesystem_type) {
         return OpenWebContentFileSystem(out, m_client_info.program_id, program_id, static_cast<FsFileSystemType>(_filesystem_type), m_forward_service.get(), nullptr, false, m_client_info.override_status.IsProgramSpecific());
     }
@@ -35,7 +35,7 @@ namespace ams::mitm::fs {
 
     class FsMitmService  : public sf::MitmServiceImplBase {
         public:
-            using MitmServiceImplBase::MitmServiceImplBase;
+            FsMitmService(std::shared_ptr<::Service> &&s, const sm::MitmProcessInfo &c);
         public:
             static constexpr ALWAYS_INLINE bool ShouldMitmProgramId(const ncm::ProgramId program_id) {
                 /* We want to mitm everything that isn't a system-module. */
@@ -132,4 +132,35 @@ namespace ams::mitm::settings {
         return ResultSuccess();
     }
 
+
+    Result SetSysMitmService::AtmosphereGetSettingsItemValues(sf::Out<s32> out_count, const sf::OutBuffer &out_values, const sf::OutArray<SettingsItemValueInfo> &out_infos, const sf::InArray<SettingsItemValueRequest> &requests) {
+        /* Get each value in turn, packing the values into the output buffer. */
+        const size_t count = std::min(out_infos.GetSize(), requests.GetSize());
+        size_t offset = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const auto &request = requests[i];
+            auto &info = out_infos[i];
+
+            /* Values which don't fit in the remaining space are truncated, as with GetSettingsItemValue. */
+            u8 *dst = out_values.GetPointer() + offset;
+            const size_t dst_size = out_values.GetSize() - offset;
+
+            /* Prefer our override value, if we have one. */
+            u64 size = 0;
+            Result result = settings::fwdbg::GetSdCardKeyValueStoreSettingsItemValue(std::addressof(size), dst, dst_size, request.name.value, request.key.value);
+            if (R_FAILED(result)) {
+                result = ::setsysGetSettingsItemValue(request.name.value, request.key.value, dst, dst_size, std::addressof(size));
+            }
+
+            info.result = result;
+            info.offset = static_cast<u32>(offset);
+            info.size   = R_SUCCEEDED(result) ? std::min<u64>(size, dst_size) : 0;
+
+            offset = std::min(util::AlignUp(offset + info.size, alignof(u64)), out_values.GetSize());
+        }
+
+        out_count.SetValue(static_cast<s32>(count));
+        return ResultSuccess();
+    }
+
 }
@@ -16,12 +16,31 @@
 #pragma once
 #include <stratosphere.hpp>
 
-#define AMS_SETTINGS_SYSTEM_MITM_INTERFACE_INFO(C, H)                                                                                                                                                                                               \
-    AMS_SF_METHOD_INFO(C, H,  3, Result, GetFirmwareVersion,       (sf::Out<ams::settings::FirmwareVersion> out),                                                                                                       (out))                      \
-    AMS_SF_METHOD_INFO(C, H,  4, Result, GetFirmwareVersion2,      (sf::Out<ams::settings::FirmwareVersion> out),                                                                                                       (out))                      \
-    AMS_SF_METHOD_INFO(C, H, 37, Result, GetSettingsItemValueSize, (sf::Out<u64> out_size, const ams::settings::SettingsName &name, const ams::settings::SettingsItemKey &key),                           (out_size, name, key))      \
-    AMS_SF_METHOD_INFO(C, H, 38, Result, GetSettingsItemValue,     (sf::Out<u64> out_size, const sf::OutBuffer &out, const ams::settings::SettingsName &name, const ams::settings::SettingsItemKey &key), (out_size, out, name, key)) \
-    AMS_SF_METHOD_INFO(C, H, 62, Result, GetDebugModeFlag,         (sf::Out<bool> out),                                                                                                                                 (out))
+namespace ams::mitm::settings {
+
+    struct SettingsItemValueRequest {
+        ams::settings::SettingsName name;
+        ams::settings::SettingsItemKey key;
+    };
+    static_assert(util::is_pod<SettingsItemValueRequest>::value);
+
+    struct SettingsItemValueInfo {
+        Result result;
+        u32 offset;
+        u64 size;
+    };
+    static_assert(util::is_pod<SettingsItemValueInfo>::value);
+    static_assert(sizeof(SettingsItemValueInfo) == 0x10);
+
+}
+
+#define AMS_SETTINGS_SYSTEM_MITM_INTERFACE_INFO(C, H)                                                                                                                                                                                                                                                                                        \
+    AMS_SF_METHOD_INFO(C, H,     3, Result, GetFirmwareVersion,              (sf::Out<ams::settings::FirmwareVersion> out),                                                                                                                                                                    (out)                                       ) \
+    AMS_SF_METHOD_INFO(C, H,     4, Result, GetFirmwareVersion2,             (sf::Out<ams::settings::FirmwareVersion> out),                                                                                                                                                                    (out)                                       ) \
+    AMS_SF_METHOD_INFO(C, H,    37, Result, GetSettingsItemValueSize,        (sf::Out<u64> out_size, const ams::settings::SettingsName &name, const ams::settings::SettingsItemKey &key),                                                                                                      (out_size, name, key)                       ) \
+    AMS_SF_METHOD_INFO(C, H,    38, Result, GetSettingsItemValue,            (sf::Out<u64> out_size, const sf::OutBuffer &out, const ams::settings::SettingsName &name, const ams::settings::SettingsItemKey &key),                                                                            (out_size, out, name, key)                  ) \
+    AMS_SF_METHOD_INFO(C, H,    62, Result, GetDebugModeFlag,                (sf::Out<bool> out),                                                                                                                                                                                              (out)                                       ) \
+    AMS_SF_METHOD_INFO(C, H, 65000, Result, AtmosphereGetSettingsItemValues, (sf::Out<s32> out_count, const sf::OutBuffer &out_values, const sf::OutArray<ams::mitm::settings::SettingsItemValueInfo> &out_infos, const sf::InArray<ams::mitm::settings::SettingsItemValueRequest> &requests), (out_count, out_values, out_infos, requests))
 
 AMS_SF_DEFINE_MITM_INTERFACE(ams::mitm::settings, ISetSysMitmInterface, AMS_SETTINGS_SYSTEM_MITM_INTERFACE_INFO)
 
@@ -44,6 +63,9 @@ namespace ams::mitm::settings {
             Result GetSettingsItemValueSize(sf::Out<u64> out_size, const ams::settings::SettingsName &name, const ams::settings::SettingsItemKey &key);
             Result GetSettingsItemValue(sf::Out<u64> out_size, const sf::OutBuffer &out, const ams::settings::SettingsName &name, const ams::settings::SettingsItemKey &key);
             Result GetDebugModeFlag(sf::Out<bool> out);
+
+            /* Atmosphere extensions. */
+            Result AtmosphereGetSettingsItemValues(sf::Out<s32> out_count, const sf::OutBuffer &out_values, const sf::OutArray<SettingsItemValueInfo> &out_infos, const sf::InArray<SettingsItemValueRequest> &requests);
     };
     static_assert(IsISetSysMitmInterface<SetSysMitmService>);
 
@@ -26,54 +26,72 @@ namespace ams::settings::fwdbg {
             const char *key;
             void *value;
             size_t value_size;
-
-            constexpr inline bool HasValue() const { return this->value != nullptr; }
-
-            constexpr inline void GetNameAndKey(char *dst) const {
-                size_t offset = 0;
-                for (size_t i = 0; i < std::strlen(this->name); i++) {
-                    dst[offset++] = this->name[i];
-                }
-                dst[offset++] = '!';
-                for (size_t i = 0; i < std::strlen(this->key); i++) {
-                    dst[offset++] = this->key[i];
-                }
-                dst[offset] = 0;
-            }
+            u32 hash;
         };
 
         static_assert(util::is_pod<SdKeyValueStoreEntry>::value);
 
-        constexpr inline bool operator==(const SdKeyValueStoreEntry &lhs, const SdKeyValueStoreEntry &rhs) {
-            if (lhs.HasValue() != rhs.HasValue()) {
-                return false;
-            }
-            return lhs.HasValue() && std::strcmp(lhs.name, rhs.name) == 0 && std::strcmp(lhs.key, rhs.key) == 0;
-        }
+        constexpr size_t MaxEntries = 0x200;
+        constexpr size_t SettingsItemValueStorageSize = 0x10000;
 
-        inline bool operator<(const SdKeyValueStoreEntry &lhs, const SdKeyValueStoreEntry &rhs) {
-            AMS_ABORT_UNLESS(lhs.HasValue());
-            AMS_ABORT_UNLESS(rhs.HasValue());
+        /* NOTE: Indices are kept at most half full, so that probe sequences remain short. */
+        constexpr size_t IndexBucketCount = 2 * MaxEntries;
+        static_assert(util::IsPowerOfTwo(IndexBucketCount));
 
-            char lhs_name_key[SettingsNameLengthMax + 1 + SettingsItemKeyLengthMax + 1];
-            char rhs_name_key[SettingsNameLengthMax + 1 + SettingsItemKeyLengthMax + 1];
+        constexpr inline u32 InitialStringHash = 0x811C9DC5;
 
-            lhs.GetNameAndKey(lhs_name_key);
-            rhs.GetNameAndKey(rhs_name_key);
+        constexpr u32 UpdateStringHash(u32 hash, const char *str) {
+            while (*str) {
+                hash = (hash ^ static_cast<u8>(*(str++))) * 0x01000193;
+            }
+            return hash;
+        }
 
-            return std::strcmp(lhs_name_key, rhs_name_key) < 0;
+        constexpr u32 GetStringHash(const char *str) {
+            return UpdateStringHash(InitialStringHash, str);
         }
 
-        constexpr size_t MaxEntries = 0x200;
-        constexpr size_t SettingsItemValueStorageSize = 0x10000;
+        constexpr u32 GetNameAndKeyHash(const char *name, const char *key) {
+            return UpdateStringHash(UpdateStringHash(UpdateStringHash(InitialStringHash, name), "!"), key);
+        }
+
+        template<typename T>
+        class InternedStringTable {
+            private:
+                T m_strings[MaxEntries];
+                size_t m_count;
+                u16 m_buckets[IndexBucketCount];
+            public:
+                Result Intern(const char **out, const char *str) {
+                    /* Look for the string, stopping at the first empty bucket. */
+                    size_t bucket = GetStringHash(str) & (IndexBucketCount - 1);
+                    for (/* ... */; m_buckets[bucket] != 0; bucket = (bucket + 1) & (IndexBucketCount - 1)) {
+                        if (const char *stored = m_strings[m_buckets[bucket] - 1].value; std::strcmp(stored, str) == 0) {
+                            *out = stored;
+                            return ResultSuccess();
+                        }
+                    }
+
+                    /* Add the string to the empty bucket. */
+                    R_UNLESS(m_count < MaxEntries, settings::ResultSettingsItemKeyAllocationFailed());
+
+                    char *stored = m_strings[m_count].value;
+                    std::strcpy(stored, str);
+                    m_buckets[bucket] = static_cast<u16>(++m_count);
+
+                    *out = stored;
+                    return ResultSuccess();
+                }
+        };
 
-        SettingsName    g_names[MaxEntries];
-        SettingsItemKey g_item_keys[MaxEntries];
+        InternedStringTable<SettingsName>    g_names;
+        InternedStringTable<SettingsItemKey> g_item_keys;
         u8 g_value_storage[SettingsItemValueStorageSize];
         size_t g_allocated_value_storage_size;
 
         SdKeyValueStoreEntry g_entries[MaxEntries];
         size_t g_num_entries;
+        u16 g_entry_buckets[IndexBucketCount];
 
         constexpr bool IsValidSettingsFormat(const char *str, size_t len) {
             AMS_ABORT_UNLESS(str != nullptr);
@@ -147,34 +165,6 @@ namespace ams::settings::fwdbg {
             return ResultSuccess();
         }
 
-        Result FindSettingsName(const char **out, const char *name) {
-            for (auto &stored : g_names) {
-                if (std::strcmp(stored.value, name) == 0) {
-                    *out = stored.value;
-                    return ResultSuccess();
-                } else if (std::strcmp(stored.value, "") == 0) {
-                    *out = stored.value;
-                    std::strcpy(stored.value, name);
-                    return ResultSuccess();
-                }
-            }
-            return settings::ResultSettingsItemKeyAllocationFailed();
-        }
-
-        Result FindSettingsItemKey(const char **out, const char *key) {
-            for (auto &stored : g_item_keys) {
-                if (std::strcmp(stored.value, key) == 0) {
-                    *out = stored.value;
-                    return ResultSuccess();
-                } else if (std::strcmp(stored.value, "") == 0) {
-                    std::strcpy(stored.value, key);
-                    *out = stored.value;
-                    return ResultSuccess();
-                }
-            }
-            return settings::ResultSettingsItemKeyAllocationFailed();
-        }
-
         template<typename T>
         Result ParseSettingsItemIntegralValue(SdKeyValueStoreEntry &out, const char *value_str) {
             R_TRY(AllocateValue(std::addressof(out.value), sizeof(T)));
@@ -185,21 +175,32 @@ namespace ams::settings::fwdbg {
             return ResultSuccess();
         }
 
+        SdKeyValueStoreEntry *FindEntry(size_t *out_bucket, const char *name, const char *key, u32 hash) {
+            /* Probe for the entry, stopping at the first empty bucket. */
+            size_t bucket = hash & (IndexBucketCount - 1);
+            for (/* ... */; g_entry_buckets[bucket] != 0; bucket = (bucket + 1) & (IndexBucketCount - 1)) {
+                SdKeyValueStoreEntry *entry = g_entries + g_entry_buckets[bucket] - 1;
+                if (entry->hash == hash && std::strcmp(entry->name, name) == 0 && std::strcmp(entry->key, key) == 0) {
+                    *out_bucket = bucket;
+                    return entry;
+                }
+            }
+
+            *out_bucket = bucket;
+            return nullptr;
+        }
+
         Result GetEntry(SdKeyValueStoreEntry **out, const char *name, const char *key) {
             /* Validate name/key. */
             R_TRY(ValidateSettingsName(name));
             R_TRY(ValidateSettingsItemKey(key));
 
-            u8 dummy_value = 0;
-            SdKeyValueStoreEntry test_entry { .name = name, .key = key, .value = std::addressof(dummy_value), .value_size = sizeof(dummy_value) };
+            /* Find the entry. */
+            size_t bucket;
+            SdKeyValueStoreEntry *entry = FindEntry(std::addressof(bucket), name, key, GetNameAndKeyHash(name, key));
+            R_UNLESS(entry != nullptr, settings::ResultSettingsItemNotFound());
 
-            auto *begin = g_entries;
-            auto *end   = begin + g_num_entries;
-            auto it = std::lower_bound(begin, end, test_entry);
-            R_UNLESS(it != end,         settings::ResultSettingsItemNotFound());
-            R_UNLESS(*it == test_entry, settings::ResultSettingsItemNotFound());
-
-            *out = std::addressof(*it);
+            *out = entry;
             return ResultSuccess();
         }
 
@@ -222,9 +223,10 @@ namespace ams::settings::fwdbg {
             /* Create new value. */
             SdKeyValueStoreEntry new_value = {};
 
-            /* Find name and key. */
-            R_TRY(FindSettingsName(std::addressof(new_value.name), name));
-            R_TRY(FindSettingsItemKey(std::addressof(new_value.key), key));
+            /* Intern name and key. */
+            R_TRY(g_names.Intern(std::addressof(new_value.name), name));
+            R_TRY(g_item_keys.Intern(std::addressof(new_value.key), key));
+            new_value.hash = GetNameAndKeyHash(new_value.name, new_value.key);
 
             if (strncasecmp(type, "str", type_len) == 0 || strncasecmp(type, "string", type_len) == 0) {
                 const size_t size = value_len + 1;
@@ -256,17 +258,18 @@ namespace ams::settings::fwdbg {
                 return settings::ResultInvalidFormatSettingsItemValue();
             }
 
-            /* Insert the entry. */
-            bool inserted = false;
-            for (auto &entry : g_entries) {
-                if (!entry.HasValue() || entry == new_value) {
-                    entry = new_value;
-                    inserted = true;
-                    break;
-                }
+            /* If we already have a value for the name and key, replace it. */
+            size_t bucket;
+            if (SdKeyValueStoreEntry *entry = FindEntry(std::addressof(bucket), new_value.name, new_value.key, new_value.hash); entry != nullptr) {
+                *entry = new_value;
+                return ResultSuccess();
             }
 
-            R_UNLESS(inserted, settings::ResultSettingsItemValueAllocationFailed());
+            /* Otherwise, insert the entry. */
+            R_UNLESS(g_num_entries < MaxEntries, settings::ResultSettingsItemValueAllocationFailed());
+
+            g_entries[g_num_entries] = new_value;
+            g_entry_buckets[bucket] = static_cast<u16>(++g_num_entries);
             return ResultSuccess();
         }
 
@@ -317,6 +320,9 @@ namespace ams::settings::fwdbg {
             /* (note: this is normally not necessary, and ips patches can be used.) */
             R_ABORT_UNLESS(ParseSettingsItemValue("ro", "ease_nro_restriction", "u8!0x1"));
 
+            /* Control whether RO should compare an NRO's hash against every NRR hash, instead of only the one it locates. */
+            R_ABORT_UNLESS(ParseSettingsItemValue("ro", "constant_time_nrr_hash_compare", "u8!0x0"));
+
             /* Control whether lm should log to the SD card. */
             /* Note that this setting does nothing when log manager is not enabled. */
             R_ABORT_UNLESS(ParseSettingsItemValue("lm", "enable_sd_card_logging", "u8!0x1"));
@@ -325,6 +331,11 @@ namespace ams::settings::fwdbg {
             /* Note that this setting does nothing when log manager is not enabled/sd card logging is not enabled. */
             R_ABORT_UNLESS(ParseSettingsItemValue("lm", "sd_card_log_output_directory", "str!atmosphere/binlogs"));
 
+            /* Control the size in bytes at which lm starts writing to a new SD card log file. */
+            /* Note that this setting does nothing when log manager is not enabled/sd card logging is not enabled. */
+            /* 0 = Never start a new log file */
+            R_ABORT_UNLESS(ParseSettingsItemValue("lm", "sd_card_log_file_size_max", "u32!0x2000000"));
+
             /* Atmosphere custom settings. */
 
             /* Reboot from fatal automatically after some number of milliseconds. */
@@ -378,6 +389,11 @@ namespace ams::settings::fwdbg {
             /* 0 = Disabled, 1 = Enabled */
             R_ABORT_UNLESS(ParseSettingsItemValue("atmosphere", "enable_htc", "u8!0x0"));
 
+            /* Controls how long htclow may wait for further packets before sending a partially filled batch, in microseconds. */
+            /* Values larger than 1000 are treated as 1000. */
+            /* 0 = Send as soon as no more packets are ready */
+            R_ABORT_UNLESS(ParseSettingsItemValue("atmosphere", "htclow_send_flush_latency_us", "u32!0x0"));
+
             /* Controls whether atmosphere's dmnt.gen2 gdbstub should run as a standalone via sockets. */
             /* Note that this setting is ignored (and treated as 0) when htc is enabled. */
             /* Note that this setting may disappear in the future. */
@@ -411,19 +427,6 @@ namespace ams::settings::fwdbg {
 
         /* Parse custom settings off the SD card. */
         R_ABORT_UNLESS(LoadSdCardKeyValueStore());
-
-        /* Determine how many custom settings are present. */
-        for (size_t i = 0; i < util::size(g_entries); i++) {
-            if (!g_entries[i].HasValue()) {
-                g_num_entries = i;
-                break;
-            }
-        }
-
-        /* Ensure that the custom settings entries are sorted. */
-        if (g_num_entries) {
-            std::sort(g_entries, g_entries + g_num_entries);
-        }
     }
 
     Result GetSdCardKeyValueStoreSettingsItemValueSize(size_t *out_size, const char *name, const char *key) {
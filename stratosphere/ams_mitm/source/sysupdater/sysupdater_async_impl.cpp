@@ -70,6 +70,14 @@ namespace ams::mitm::sysupdater {
     }
 
     Result AsyncPrepareSdCardUpdateImpl::Execute() {
+        /* The install buffer is only used to write placeholders, so free it once we're done, whether or not we succeed. */
+        ON_SCOPE_EXIT {
+            if (m_install_buffer != nullptr) {
+                std::free(m_install_buffer);
+                m_install_buffer = nullptr;
+            }
+        };
+
         return m_task->PrepareAndExecute();
     }
 
@@ -97,8 +97,9 @@ namespace ams::mitm::sysupdater {
             os::SystemEvent m_event;
             util::optional<ThreadInfo> m_thread_info;
             ncm::InstallTaskBase *m_task;
+            void *m_install_buffer;
         public:
-            AsyncPrepareSdCardUpdateImpl(ncm::InstallTaskBase *task) : m_result(ResultSuccess()), m_event(os::EventClearMode_ManualClear, true), m_thread_info(), m_task(task) { /* ... */ }
+            AsyncPrepareSdCardUpdateImpl(ncm::InstallTaskBase *task, void *install_buffer) : m_result(ResultSuccess()), m_event(os::EventClearMode_ManualClear, true), m_thread_info(), m_task(task), m_install_buffer(install_buffer) { /* ... */ }
             virtual ~AsyncPrepareSdCardUpdateImpl();
 
             os::SystemEvent &GetEvent() { return m_event; }
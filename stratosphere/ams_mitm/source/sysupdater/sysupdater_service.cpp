@@ -25,6 +25,9 @@ namespace ams::mitm::sysupdater {
         /* ExFat NCAs prior to 2.0.0 do not actually include the exfat driver, and don't boot. */
         constexpr inline u32 MinimumVersionForExFatDriver = 65536;
 
+        /* Limit how much memory we'll take for an install buffer, leaving room for everything else we do. */
+        constexpr inline size_t InstallBufferSizeMax = 4_MB;
+
         bool IsExFatDriverSupported(const ncm::ContentMetaInfo &info) {
             return info.version >= MinimumVersionForExFatDriver && ((info.attributes & ncm::ContentMetaAttribute_IncludesExFatDriver) != 0);
         }
@@ -324,6 +327,15 @@ namespace ams::mitm::sysupdater {
 
     }
 
+    SystemUpdateService::~SystemUpdateService() {
+        /* Destroy the update task before freeing the buffer it uses. */
+        m_update_task = util::nullopt;
+
+        if (m_install_buffer != nullptr) {
+            std::free(m_install_buffer);
+        }
+    }
+
     Result SystemUpdateService::GetUpdateInformation(sf::Out<UpdateInformation> out, const ncm::Path &path) {
         /* Adjust the path. */
         ncm::Path package_root;
@@ -424,12 +436,15 @@ namespace ams::mitm::sysupdater {
         R_UNLESS(!m_requested_update, ns::ResultPrepareCardUpdateAlreadyRequested());
 
         /* Create the async result. */
-        auto async_result = sf::CreateSharedObjectEmplaced<ns::impl::IAsyncResult, AsyncPrepareSdCardUpdateImpl>(std::addressof(*m_update_task));
+        auto async_result = sf::CreateSharedObjectEmplaced<ns::impl::IAsyncResult, AsyncPrepareSdCardUpdateImpl>(std::addressof(*m_update_task), m_install_buffer);
         R_UNLESS(async_result != nullptr, ns::ResultOutOfMaxRunningTask());
 
         /* Run the task. */
         R_TRY(async_result.GetImpl().Run());
 
+        /* The running task now owns our install buffer, and will free it once the prepare finishes. */
+        m_install_buffer = nullptr;
+
         /* We prepared the task! */
         m_requested_update = true;
         out_event_handle.SetValue(async_result.GetImpl().GetEvent().GetReadableHandle(), false);
@@ -448,6 +463,27 @@ namespace ams::mitm::sysupdater {
         return ResultSuccess();
     }
 
+    Result SystemUpdateService::GetPrepareUpdateThroughput(sf::Out<SystemUpdateThroughput> out) {
+        /* Ensure the update is setup. */
+        R_UNLESS(m_setup_update, ns::ResultCardUpdateNotSetup());
+
+        /* Get the throughput, both overall and for each stage of writing content. */
+        const auto total = m_update_task->GetThroughput();
+        const auto stage = m_update_task->GetStageThroughput();
+
+        auto ConvertThroughput = [](const ncm::InstallThroughput &throughput) ALWAYS_INLINE_LAMBDA -> SystemUpdateStageThroughput {
+            return { .size = throughput.installed, .elapsed_time_ns = throughput.elapsed_time.GetNanoSeconds() };
+        };
+
+        out.SetValue({
+            .total = ConvertThroughput(total),
+            .read  = ConvertThroughput(stage.read),
+            .hash  = ConvertThroughput(stage.hash),
+            .write = ConvertThroughput(stage.write),
+        });
+        return ResultSuccess();
+    }
+
     Result SystemUpdateService::HasPreparedUpdate(sf::Out<bool> out) {
         /* Ensure the update is setup. */
         R_UNLESS(m_setup_update, ns::ResultCardUpdateNotSetup());
@@ -509,11 +545,38 @@ namespace ams::mitm::sysupdater {
         R_TRY(fs::EnsureDirectoryRecursively("@Sdcard:/atmosphere/update/"));
         const char *context_path = "@Sdcard:/atmosphere/update/cup.ctx";
 
+        /* Install with a larger buffer than the one we were given, if we have the memory to spare. */
+        /* NOTE: Larger buffers let the install task read, hash, and write contents in larger, overlapping chunks. */
+        /* Our heap is shared with everything else we do (e.g. fs_mitm romfs building), so we only take up to half of its free space. */
+        const size_t spare_size    = init::GetAllocator()->GetTotalFreeSize() / 2;
+        void *install_buffer       = tmem_buffer;
+        size_t install_buffer_size = tmem_buffer_size;
+        for (size_t size = InstallBufferSizeMax; size > tmem_buffer_size; size /= 2) {
+            if (size > spare_size) {
+                continue;
+            }
+
+            if (void *buffer = std::aligned_alloc(os::MemoryPageSize, size); buffer != nullptr) {
+                install_buffer      = buffer;
+                install_buffer_size = size;
+                break;
+            }
+        }
+        auto install_buffer_guard = SCOPE_GUARD {
+            if (install_buffer != tmem_buffer) {
+                std::free(install_buffer);
+            }
+        };
+
         /* Create and initialize the update task. */
         m_update_task.emplace();
-        R_TRY(m_update_task->Initialize(package_root.str, context_path, tmem_buffer, tmem_buffer_size, exfat, firmware_variation_id));
+        R_TRY(m_update_task->Initialize(package_root.str, context_path, install_buffer, install_buffer_size, exfat, firmware_variation_id));
 
         /* We successfully setup the update. */
+        if (install_buffer != tmem_buffer) {
+            m_install_buffer = install_buffer;
+        }
+        install_buffer_guard.Cancel();
         tmem_guard.Cancel();
 
         return ResultSuccess();
@@ -38,6 +38,18 @@ namespace ams::mitm::sysupdater {
         s64 total_size;
     };
 
+    struct SystemUpdateStageThroughput {
+        s64 size;
+        s64 elapsed_time_ns;
+    };
+
+    struct SystemUpdateThroughput {
+        SystemUpdateStageThroughput total;
+        SystemUpdateStageThroughput read;
+        SystemUpdateStageThroughput hash;
+        SystemUpdateStageThroughput write;
+    };
+
 }
 
 #define AMS_SYSUPDATER_SYSTEM_UPDATE_INTERFACE_INFO(C, H)                                                                                                                                                                                                                                                                             \
@@ -48,7 +60,8 @@ namespace ams::mitm::sysupdater {
     AMS_SF_METHOD_INFO(C, H, 4, Result, RequestPrepareUpdate,     (sf::OutCopyHandle out_event_handle, sf::Out<sf::SharedPointer<ns::impl::IAsyncResult>> out_async),                                                                         (out_event_handle, out_async))                                                          \
     AMS_SF_METHOD_INFO(C, H, 5, Result, GetPrepareUpdateProgress, (sf::Out<mitm::sysupdater::SystemUpdateProgress> out),                                                                                                                      (out))                                                                                  \
     AMS_SF_METHOD_INFO(C, H, 6, Result, HasPreparedUpdate,        (sf::Out<bool> out),                                                                                                                                                        (out))                                                                                  \
-    AMS_SF_METHOD_INFO(C, H, 7, Result, ApplyPreparedUpdate,      (),                                                                                                                                                                         ())
+    AMS_SF_METHOD_INFO(C, H, 7, Result, ApplyPreparedUpdate,      (),                                                                                                                                                                         ())                                                                                     \
+    AMS_SF_METHOD_INFO(C, H, 8, Result, GetPrepareUpdateThroughput, (sf::Out<mitm::sysupdater::SystemUpdateThroughput> out), (out))
 
 AMS_SF_DEFINE_INTERFACE(ams::mitm::sysupdater::impl, ISystemUpdateInterface, AMS_SYSUPDATER_SYSTEM_UPDATE_INTERFACE_INFO)
 
@@ -59,10 +72,12 @@ namespace ams::mitm::sysupdater {
             SystemUpdateApplyManager m_apply_manager;
             util::optional<ncm::PackageSystemDowngradeTask> m_update_task;
             util::optional<os::TransferMemory> m_update_transfer_memory;
+            void *m_install_buffer;
             bool m_setup_update;
             bool m_requested_update;
         public:
-            constexpr SystemUpdateService() : m_apply_manager(), m_update_task(), m_update_transfer_memory(), m_setup_update(false), m_requested_update(false) { /* ... */ }
+            constexpr SystemUpdateService() : m_apply_manager(), m_update_task(), m_update_transfer_memory(), m_install_buffer(nullptr), m_setup_update(false), m_requested_update(false) { /* ... */ }
+            ~SystemUpdateService();
         private:
             Result SetupUpdateImpl(sf::NativeHandle &&transfer_memory, u64 transfer_memory_size, const ncm::Path &path, bool exfat, ncm::FirmwareVariationId firmware_variation_id);
             Result InitializeUpdateTask(sf::NativeHandle &&transfer_memory, u64 transfer_memory_size, const ncm::Path &path, bool exfat, ncm::FirmwareVariationId firmware_variation_id);
@@ -75,6 +90,7 @@ namespace ams::mitm::sysupdater {
             Result GetPrepareUpdateProgress(sf::Out<SystemUpdateProgress> out);
             Result HasPreparedUpdate(sf::Out<bool> out);
             Result ApplyPreparedUpdate();
+            Result GetPrepareUpdateThroughput(sf::Out<SystemUpdateThroughput> out);
     };
     static_assert(impl::IsISystemUpdateInterface<SystemUpdateService>);
 
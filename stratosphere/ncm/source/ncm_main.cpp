@@ -154,9 +154,15 @@ namespace ams {
             constexpr inline bool ImportSystemDatabaseFromSignedSystemPartitionOnSdCard = false;
         #endif
 
+        #ifdef NCM_ENABLE_CONTENT_ID_INDEX
+            constexpr inline bool EnableContentIdIndex = true;
+        #else
+            constexpr inline bool EnableContentIdIndex = false;
+        #endif
+
             static_assert(!(BuildSystemDatabase && ImportSystemDatabaseFromSignedSystemPartitionOnSdCard), "Invalid NCM build configuration!");
 
-            constexpr inline ncm::ContentManagerConfig ManagerConfig = { BuildSystemDatabase, ImportSystemDatabaseFromSignedSystemPartitionOnSdCard };
+            constexpr inline ncm::ContentManagerConfig ManagerConfig = { BuildSystemDatabase, ImportSystemDatabaseFromSignedSystemPartitionOnSdCard, EnableContentIdIndex };
 
         }
 
@@ -39,6 +39,10 @@ namespace ams::pm::impl {
             };
         private:
             util::IntrusiveListNode m_list_node;
+            util::IntrusiveListNode m_event_list_node;
+            ProcessInfo *m_process_id_hash_next;
+            ProcessInfo *m_program_id_hash_next;
+            u64 m_list_sequence;
             const os::ProcessId m_process_id;
             const ldr::PinId m_pin_id;
             const ncm::ProgramLocation m_loc;
@@ -166,10 +170,53 @@ namespace ams::pm::impl {
     };
 
     class ProcessList final : public util::IntrusiveListMemberTraits<&ProcessInfo::m_list_node>::ListType {
+        private:
+            using BaseList  = util::IntrusiveListMemberTraits<&ProcessInfo::m_list_node>::ListType;
+            using EventList = util::IntrusiveListMemberTraits<&ProcessInfo::m_event_list_node>::ListType;
+
+            /* NOTE: Processes are additionally indexed by process id and program id, in hash chains ordered by insertion. */
+            /* Insertion order matches list order, so finding by program id still returns the oldest matching process. */
+            static constexpr size_t HashBucketShift = 6;
+            static constexpr size_t HashBucketCount = 1 << HashBucketShift;
         private:
             os::SdkMutex m_lock;
+            EventList m_event_list;
+            ProcessInfo *m_process_id_buckets[HashBucketCount];
+            ProcessInfo *m_program_id_buckets[HashBucketCount];
+            u64 m_next_list_sequence;
+        private:
+            static constexpr ALWAYS_INLINE size_t GetBucketIndex(u64 key) {
+                return static_cast<size_t>((key * UINT64_C(0x9E3779B97F4A7C15)) >> (BITSIZEOF(u64) - HashBucketShift));
+            }
+
+            static void LinkToBucket(ProcessInfo **bucket, ProcessInfo *process_info, ProcessInfo *ProcessInfo::*next) {
+                while (*bucket != nullptr) {
+                    bucket = std::addressof((*bucket)->*next);
+                }
+
+                *bucket = process_info;
+                process_info->*next = nullptr;
+            }
+
+            static void UnlinkFromBucket(ProcessInfo **bucket, ProcessInfo *process_info, ProcessInfo *ProcessInfo::*next) {
+                while (*bucket != process_info) {
+                    AMS_ASSERT(*bucket != nullptr);
+                    bucket = std::addressof((*bucket)->*next);
+                }
+
+                *bucket = process_info->*next;
+                process_info->*next = nullptr;
+            }
+
+            ProcessInfo **GetBucket(os::ProcessId process_id) {
+                return std::addressof(m_process_id_buckets[GetBucketIndex(process_id.value)]);
+            }
+
+            ProcessInfo **GetBucket(ncm::ProgramId program_id) {
+                return std::addressof(m_program_id_buckets[GetBucketIndex(program_id.value)]);
+            }
         public:
-            constexpr ProcessList() : m_lock() { /* ... */ }
+            constexpr ProcessList() : m_lock(), m_event_list(), m_process_id_buckets(), m_program_id_buckets(), m_next_list_sequence(0) { /* ... */ }
 
             void Lock() {
                 m_lock.Lock();
@@ -179,28 +226,64 @@ namespace ams::pm::impl {
                 m_lock.Unlock();
             }
 
+            void push_back(ProcessInfo &process_info) {
+                BaseList::push_back(process_info);
+                process_info.m_list_sequence = m_next_list_sequence++;
+
+                LinkToBucket(this->GetBucket(process_info.GetProcessId()), std::addressof(process_info), &ProcessInfo::m_process_id_hash_next);
+                LinkToBucket(this->GetBucket(process_info.GetProgramLocation().program_id), std::addressof(process_info), &ProcessInfo::m_program_id_hash_next);
+            }
+
             void Remove(ProcessInfo *process_info) {
+                UnlinkFromBucket(this->GetBucket(process_info->GetProcessId()), process_info, &ProcessInfo::m_process_id_hash_next);
+                UnlinkFromBucket(this->GetBucket(process_info->GetProgramLocation().program_id), process_info, &ProcessInfo::m_program_id_hash_next);
+
+                if (process_info->m_event_list_node.IsLinked()) {
+                    m_event_list.erase(m_event_list.iterator_to(*process_info));
+                }
+
                 this->erase(this->iterator_to(*process_info));
             }
 
             ProcessInfo *Find(os::ProcessId process_id) {
-                for (auto &info : *this) {
-                    if (info.GetProcessId() == process_id) {
-                        return std::addressof(info);
+                for (auto *info = *this->GetBucket(process_id); info != nullptr; info = info->m_process_id_hash_next) {
+                    if (info->GetProcessId() == process_id) {
+                        return info;
                     }
                 }
                 return nullptr;
             }
 
             ProcessInfo *Find(ncm::ProgramId program_id) {
-                for (auto &info : *this) {
-                    if (info.GetProgramLocation().program_id == program_id) {
-                        return std::addressof(info);
+                for (auto *info = *this->GetBucket(program_id); info != nullptr; info = info->m_program_id_hash_next) {
+                    if (info->GetProgramLocation().program_id == program_id) {
+                        return info;
                     }
                 }
                 return nullptr;
             }
 
+            /* Processes whose state changed in a way that may produce a process event are queued, so that */
+            /* the process event handler need not scan every process. */
+            /* NOTE: The queue is kept in list order, so that events are reported in the same order as a scan of the list would. */
+            void NotifyEvent(ProcessInfo *process_info) {
+                if (!process_info->m_event_list_node.IsLinked()) {
+                    auto it = m_event_list.begin();
+                    while (it != m_event_list.end() && it->m_list_sequence < process_info->m_list_sequence) {
+                        ++it;
+                    }
+
+                    m_event_list.insert(it, *process_info);
+                }
+            }
+
+            ProcessInfo *GetNextEventProcess() {
+                return !m_event_list.empty() ? std::addressof(m_event_list.front()) : nullptr;
+            }
+
+            void ClearEvent(ProcessInfo *process_info) {
+                m_event_list.erase(m_event_list.iterator_to(*process_info));
+            }
     };
 
     class ProcessListAccessor final {
@@ -338,10 +338,12 @@ namespace ams::pm::impl {
                     if (process_info->ShouldSignalOnDebugEvent()) {
                         process_info->ClearSuspended();
                         process_info->SetSuspendedStateChanged();
+                        list->NotifyEvent(process_info);
                         os::SignalSystemEvent(std::addressof(g_process_event));
                     } else if (hos::GetVersion() >= hos::Version_2_0_0 && process_info->ShouldSignalOnStart()) {
                         process_info->SetStartedStateChanged();
                         process_info->ClearSignalOnStart();
+                        list->NotifyEvent(process_info);
                         os::SignalSystemEvent(std::addressof(g_process_event));
                     }
                     process_info->ClearUnhandledException();
@@ -349,6 +351,7 @@ namespace ams::pm::impl {
                 case svc::ProcessState_Crashed:
                     if (!process_info->HasUnhandledException()) {
                         process_info->SetExceptionOccurred();
+                        list->NotifyEvent(process_info);
                         os::SignalSystemEvent(std::addressof(g_process_event));
                     }
                     process_info->SetExceptionWaitingAttach();
@@ -357,6 +360,7 @@ namespace ams::pm::impl {
                     if (process_info->ShouldSignalOnDebugEvent()) {
                         process_info->ClearSuspended();
                         process_info->SetSuspendedStateChanged();
+                        list->NotifyEvent(process_info);
                         os::SignalSystemEvent(std::addressof(g_process_event));
                     }
                     process_info->ClearUnhandledException();
@@ -366,6 +370,7 @@ namespace ams::pm::impl {
                     process_info->Cleanup();
 
                     if (hos::GetVersion() < hos::Version_5_0_0 && process_info->ShouldSignalOnExit()) {
+                        list->NotifyEvent(process_info);
                         os::SignalSystemEvent(std::addressof(g_process_event));
                     } else {
                         /* Handle the case where we need to keep the process alive some time longer. */
@@ -391,6 +396,7 @@ namespace ams::pm::impl {
                     if (process_info->ShouldSignalOnDebugEvent()) {
                         process_info->SetSuspended();
                         process_info->SetSuspendedStateChanged();
+                        list->NotifyEvent(process_info);
                         os::SignalSystemEvent(std::addressof(g_process_event));
                     }
                     break;
@@ -478,7 +484,10 @@ namespace ams::pm::impl {
             ProcessListAccessor list(g_process_list);
 
 
-            for (auto &process : *list) {
+            /* Only processes which have been notified of a state change can have a pending event. */
+            while (auto *process_info = list->GetNextEventProcess()) {
+                auto &process = *process_info;
+
                 if (process.HasStarted() && process.HasStartedStateChanged()) {
                     process.ClearStartedStateChanged();
                     out->event = GetProcessEventValue(ProcessEvent::Started);
@@ -506,6 +515,9 @@ namespace ams::pm::impl {
                     out->process_id = process.GetProcessId();
                     return ResultSuccess();
                 }
+
+                /* The process has no remaining pending events. */
+                list->ClearEvent(process_info);
             }
         }
 
@@ -109,6 +109,47 @@ namespace ams::ro::impl {
             }
         };
 
+        /* Cache of NRRs whose signatures have been verified since boot. */
+        /* An entry is keyed by the hash of the header before the signed area, which covers the certification and signature, */
+        /* and by the hash of the signed area. Together, these cover all the data that was verified. */
+        constexpr size_t VerifiedNrrCacheCount = 0x40;
+
+        struct VerifiedNrrCacheEntry {
+            u8 header_hash[crypto::Sha256Generator::HashSize];
+            u8 signed_area_hash[crypto::Sha256Generator::HashSize];
+        };
+
+        constinit os::SdkMutex g_verified_nrr_cache_mutex;
+        constinit VerifiedNrrCacheEntry g_verified_nrr_cache[VerifiedNrrCacheCount];
+        constinit size_t g_verified_nrr_cache_count = 0;
+        constinit size_t g_verified_nrr_cache_next  = 0;
+
+        void MakeVerifiedNrrCacheEntry(VerifiedNrrCacheEntry *out, const NrrHeader *header, const void *signed_area_hash) {
+            crypto::GenerateSha256Hash(out->header_hash, sizeof(out->header_hash), header, NrrHeader::GetSignedAreaOffset());
+            std::memcpy(out->signed_area_hash, signed_area_hash, sizeof(out->signed_area_hash));
+        }
+
+        bool IsVerifiedNrr(const VerifiedNrrCacheEntry &entry) {
+            std::scoped_lock lk(g_verified_nrr_cache_mutex);
+
+            for (size_t i = 0; i < g_verified_nrr_cache_count; ++i) {
+                if (std::memcmp(std::addressof(g_verified_nrr_cache[i]), std::addressof(entry), sizeof(entry)) == 0) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        void SetVerifiedNrr(const VerifiedNrrCacheEntry &entry) {
+            std::scoped_lock lk(g_verified_nrr_cache_mutex);
+
+            /* Replace the oldest entry. */
+            g_verified_nrr_cache[g_verified_nrr_cache_next] = entry;
+            g_verified_nrr_cache_next  = (g_verified_nrr_cache_next + 1) % VerifiedNrrCacheCount;
+            g_verified_nrr_cache_count = std::min(g_verified_nrr_cache_count + 1, VerifiedNrrCacheCount);
+        }
+
         /* Helper functions. */
 
         Result GetCertificationModulus(const u8 **out, u32 key_generation) {
@@ -158,7 +199,7 @@ namespace ams::ro::impl {
             return ResultSuccess();
         }
 
-        Result ValidateNrr(const NrrHeader *header, u64 size, ncm::ProgramId program_id, NrrKind nrr_kind, bool enforce_nrr_kind) {
+        Result ValidateNrr(const NrrHeader *header, u64 size, const void *signed_area_hash, ncm::ProgramId program_id, NrrKind nrr_kind, bool enforce_nrr_kind) {
             /* Check magic. */
             R_UNLESS(header->IsMagicValid(), ro::ResultInvalidNrr());
 
@@ -174,11 +215,20 @@ namespace ams::ro::impl {
             R_TRY(GetCertificationModulus(std::addressof(modulus), header->GetKeyGeneration()));
 
             if (!ease_nro_restriction) {
-                /* Check certification signature. */
-                R_TRY(ValidateNrrCertification(header, modulus));
+                /* Check whether we've already verified the signatures for an identical NRR. */
+                VerifiedNrrCacheEntry cache_entry;
+                MakeVerifiedNrrCacheEntry(std::addressof(cache_entry), header, signed_area_hash);
+
+                if (!IsVerifiedNrr(cache_entry)) {
+                    /* Check certification signature. */
+                    R_TRY(ValidateNrrCertification(header, modulus));
+
+                    /* Check NRR signature. */
+                    R_TRY(ValidateNrrSignature(header));
 
-                /* Check NRR signature. */
-                R_TRY(ValidateNrrSignature(header));
+                    /* Remember that we verified the signatures. */
+                    SetVerifiedNrr(cache_entry);
+                }
 
                 /* Check program id. */
                 R_UNLESS(header->GetProgramId() == program_id, ro::ResultInvalidNrr());
@@ -235,14 +285,23 @@ namespace ams::ro::impl {
         R_TRY(nrr_map.GetResult());
 
         NrrHeader *nrr_header = reinterpret_cast<NrrHeader *>(map_address);
-        R_TRY(ValidateNrr(nrr_header, nrr_heap_size, program_id, nrr_kind, enforce_nrr_kind));
+        /* Check the header is sane before hashing it. */
+        R_UNLESS(nrr_header->IsMagicValid(),             ro::ResultInvalidNrr());
+        R_UNLESS(nrr_header->GetSize() == nrr_heap_size, ro::ResultInvalidSize());
+
+        /* Hash the signed area. This is the hash all further validation is bound to. */
+        u8 signed_area_hash[crypto::Sha256Generator::HashSize];
+        AMS_ABORT_UNLESS(out_hash_size == sizeof(signed_area_hash));
+        crypto::GenerateSha256Hash(signed_area_hash, sizeof(signed_area_hash), nrr_header->GetSignedArea(), nrr_header->GetSignedAreaSize());
+
+        R_TRY(ValidateNrr(nrr_header, nrr_heap_size, signed_area_hash, program_id, nrr_kind, enforce_nrr_kind));
 
         /* Cancel the automatic closing of our mappings. */
         nrr_map.Cancel();
         nrr_mcm.Cancel();
 
         /* Save a copy of the hash that we verified. */
-        crypto::GenerateSha256Hash(out_hash, out_hash_size, nrr_header->GetSignedArea(), nrr_header->GetSignedAreaSize());
+        std::memcpy(out_hash, signed_area_hash, sizeof(signed_area_hash));
 
         *out_header              = nrr_header;
         *out_mapped_code_address = code_address;
@@ -255,7 +314,10 @@ namespace ams::ro::impl {
         return ResultSuccess();
     }
 
-    bool ValidateNrrHashTableEntry(const void *signed_area, size_t signed_area_size, size_t hashes_offset, size_t num_hashes, const void *nrr_hash, const u8 *hash_table, const void *desired_hash) {
+    bool ValidateNrrHashTableEntry(const void *signed_area, size_t signed_area_size, size_t hashes_offset, size_t num_hashes, const void *nrr_hash, const u8 *hash_table, size_t desired_index, const void *desired_hash) {
+        /* Determine whether we should compare against every entry, rather than only the one located by the caller. */
+        const bool constant_time_compare = ShouldUseConstantTimeNrrHashCompare();
+
         crypto::Sha256Generator sha256;
         sha256.Initialize();
 
@@ -276,7 +338,12 @@ namespace ams::ro::impl {
             sha256.Update(cur_hash, sizeof(cur_hash));
 
             /* Check if the current hash is our target. */
-            found_hash |= std::memcmp(cur_hash, desired_hash, sizeof(cur_hash)) == 0;
+            /* NOTE: We compare against the copy we hashed, so that the entry can't change between being compared and being hashed. */
+            if (constant_time_compare) {
+                found_hash |= std::memcmp(cur_hash, desired_hash, sizeof(cur_hash)) == 0;
+            } else if (i == desired_index) {
+                found_hash = std::memcmp(cur_hash, desired_hash, sizeof(cur_hash)) == 0;
+            }
 
             /* Advance our pointers. */
             hash_table     += sizeof(cur_hash);
@@ -236,7 +236,8 @@ namespace ams::ro::impl {
                         const size_t hashes_offset    = m_nrr_infos[i].cached_hashes_offset;
                         const size_t num_hashes       = m_nrr_infos[i].cached_num_hashes;
                         const u8 *hash_table          = reinterpret_cast<const u8 *>(mapped_nro_hashes_start);
-                        if (!ValidateNrrHashTableEntry(signed_area, signed_area_size, hashes_offset, num_hashes, nrr_hash, hash_table, std::addressof(hash))) {
+                        const size_t hash_index       = mapped_lower_bound - mapped_nro_hashes_start;
+                        if (!ValidateNrrHashTableEntry(signed_area, signed_area_size, hashes_offset, num_hashes, nrr_hash, hash_table, hash_index, std::addressof(hash))) {
                             continue;
                         }
 
@@ -432,6 +433,20 @@ namespace ams::ro::impl {
         return should_ease != 0;
     }
 
+    bool ShouldUseConstantTimeNrrHashCompare() {
+        /* This can't change at runtime, so we only retrieve it from set:sys once. */
+        AMS_FUNCTION_LOCAL_STATIC(bool, s_use_constant_time_compare, [] {
+            u8 use_constant_time_compare = 0;
+            if (settings::fwdbg::GetSettingsItemValue(std::addressof(use_constant_time_compare), sizeof(use_constant_time_compare), "ro", "constant_time_nrr_hash_compare") != sizeof(use_constant_time_compare)) {
+                return false;
+            }
+
+            return use_constant_time_compare != 0;
+        }());
+
+        return s_use_constant_time_compare;
+    }
+
     /* Context utilities. */
     Result RegisterProcess(size_t *out_context_id, sf::NativeHandle &&process_handle, os::ProcessId process_id) {
         /* Validate process handle. */
@@ -28,6 +28,7 @@ namespace ams::ro::impl {
     bool IsDevelopmentHardware();
     bool IsDevelopmentFunctionEnabled();
     bool ShouldEaseNroRestriction();
+    bool ShouldUseConstantTimeNrrHashCompare();
 
     /* Context utilities. */
     Result RegisterProcess(size_t *out_context_id, sf::NativeHandle &&process_handle, os::ProcessId process_id);
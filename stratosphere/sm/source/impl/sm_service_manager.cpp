@@ -154,6 +154,115 @@ namespace ams::sm::impl {
                 }
         };
 
+        struct LookupStatistics {
+            u64 lookup_count;
+            u64 probe_count;
+            u32 max_probe_length;
+        };
+
+        /* Open-addressed (linear probing) index from an 8-byte key to the index of an info in one of the fixed info lists. */
+        template<size_t EntryCountMax>
+        class InfoIndex {
+            private:
+                static constexpr size_t SlotCount         = util::CeilingPowerOfTwo(EntryCountMax * 2);
+                static constexpr u16    InvalidEntryIndex = std::numeric_limits<u16>::max();
+                static_assert(EntryCountMax < InvalidEntryIndex);
+
+                struct Slot {
+                    u64 key;
+                    u16 entry_index;
+                };
+            private:
+                std::array<Slot, SlotCount> m_slots;
+                LookupStatistics m_statistics;
+            private:
+                static constexpr ALWAYS_INLINE size_t GetHomeSlot(u64 key) {
+                    return static_cast<size_t>((key * UINT64_C(0x9E3779B97F4A7C15)) >> 32) & (SlotCount - 1);
+                }
+
+                static constexpr ALWAYS_INLINE size_t GetNextSlot(size_t slot) {
+                    return (slot + 1) & (SlotCount - 1);
+                }
+            public:
+                constexpr InfoIndex() : m_slots(), m_statistics() {
+                    for (auto &slot : m_slots) {
+                        slot = { .key = 0, .entry_index = InvalidEntryIndex };
+                    }
+                }
+
+                s32 Find(u64 key) {
+                    /* Probe until we find the key or an empty slot. */
+                    u32 probe_length = 1;
+                    size_t slot = GetHomeSlot(key);
+                    while (m_slots[slot].entry_index != InvalidEntryIndex && m_slots[slot].key != key) {
+                        slot = GetNextSlot(slot);
+                        ++probe_length;
+                    }
+
+                    /* Update our statistics. */
+                    m_statistics.lookup_count     += 1;
+                    m_statistics.probe_count      += probe_length;
+                    m_statistics.max_probe_length  = std::max(m_statistics.max_probe_length, probe_length);
+
+                    return m_slots[slot].entry_index != InvalidEntryIndex ? static_cast<s32>(m_slots[slot].entry_index) : -1;
+                }
+
+                void Insert(u64 key, size_t entry_index) {
+                    AMS_ASSERT(entry_index < EntryCountMax);
+
+                    /* Find an empty slot. The table is at most half full, so one always exists. */
+                    size_t slot = GetHomeSlot(key);
+                    while (m_slots[slot].entry_index != InvalidEntryIndex) {
+                        slot = GetNextSlot(slot);
+                    }
+
+                    m_slots[slot] = { .key = key, .entry_index = static_cast<u16>(entry_index) };
+                }
+
+                void Erase(u64 key, size_t entry_index) {
+                    /* Find the slot for the entry. */
+                    size_t slot = GetHomeSlot(key);
+                    while (m_slots[slot].entry_index != entry_index || m_slots[slot].key != key) {
+                        if (m_slots[slot].entry_index == InvalidEntryIndex) {
+                            return;
+                        }
+                        slot = GetNextSlot(slot);
+                    }
+
+                    /* Remove the entry, shifting back any following entries which would otherwise become unreachable. */
+                    size_t hole = slot;
+                    for (size_t cur = GetNextSlot(hole); m_slots[cur].entry_index != InvalidEntryIndex; cur = GetNextSlot(cur)) {
+                        const size_t home = GetHomeSlot(m_slots[cur].key);
+                        if (((cur - home) & (SlotCount - 1)) >= ((cur - hole) & (SlotCount - 1))) {
+                            m_slots[hole] = m_slots[cur];
+                            hole = cur;
+                        }
+                    }
+
+                    m_slots[hole] = { .key = 0, .entry_index = InvalidEntryIndex };
+                }
+
+                const LookupStatistics &GetStatistics() const {
+                    return m_statistics;
+                }
+        };
+
+        void LogLookupStatistics(const char *name, const LookupStatistics &statistics) {
+            AMS_UNUSED(name, statistics);
+            AMS_LOG("[sm] %s index: %" PRIu64 " lookups, %" PRIu64 " probes, max probe length %u\n", name, statistics.lookup_count, statistics.probe_count, statistics.max_probe_length);
+        }
+
+        constexpr ALWAYS_INLINE u64 GetIndexKey(os::ProcessId process_id) {
+            return process_id.value;
+        }
+
+        ALWAYS_INLINE u64 GetIndexKey(ServiceName service) {
+            u64 key;
+            std::memcpy(std::addressof(key), std::addressof(service), sizeof(key));
+            return key;
+        }
+        static_assert(sizeof(ServiceName) == sizeof(u64));
+
         /* Static members. */
 
         /* NOTE: In 12.0.0, Nintendo added multithreaded processing to sm; however, official sm does not do */
@@ -206,6 +315,10 @@ namespace ams::sm::impl {
             return list;
         }();
 
+        /* Indices used to locate process and service infos by process id and service name, respectively. */
+        constinit InfoIndex<ProcessCountMax> g_process_index;
+        constinit InfoIndex<ServiceCountMax> g_service_index;
+
         constinit bool g_ended_initial_defers = false;
 
         const InitialProcessIdLimits g_initial_process_id_limits;
@@ -291,8 +404,17 @@ namespace ams::sm::impl {
 
         ProcessInfo *GetProcessInfo(os::ProcessId process_id) {
             /* Find a process info with a matching id. */
+            if (const s32 index = g_process_index.Find(GetIndexKey(process_id)); index >= 0) {
+                return std::addressof(g_process_list[index]);
+            }
+
+            return nullptr;
+        }
+
+        ProcessInfo *GetFreeProcessInfo() {
+            /* Find a process info without an owner. */
             for (auto &process_info : g_process_list) {
-                if (process_info.process_id == process_id) {
+                if (process_info.process_id == os::InvalidProcessId) {
                     return std::addressof(process_info);
                 }
             }
@@ -300,8 +422,19 @@ namespace ams::sm::impl {
             return nullptr;
         }
 
-        ProcessInfo *GetFreeProcessInfo() {
-            return GetProcessInfo(os::InvalidProcessId);
+        void SetProcessId(ProcessInfo *process_info, os::ProcessId process_id) {
+            const size_t index = process_info - g_process_list.data();
+
+            /* Update the index. */
+            if (IsValidProcessId(process_info->process_id)) {
+                g_process_index.Erase(GetIndexKey(process_info->process_id), index);
+            }
+            if (IsValidProcessId(process_id)) {
+                g_process_index.Insert(GetIndexKey(process_id), index);
+            }
+
+            /* Set the process id. */
+            process_info->process_id = process_id;
         }
 
         bool HasProcessInfo(os::ProcessId process_id) {
@@ -310,8 +443,17 @@ namespace ams::sm::impl {
 
         ServiceInfo *GetServiceInfo(ServiceName service_name) {
             /* Find a service with a matching name. */
+            if (const s32 index = g_service_index.Find(GetIndexKey(service_name)); index >= 0) {
+                return std::addressof(g_service_list[index]);
+            }
+
+            return nullptr;
+        }
+
+        ServiceInfo *GetFreeServiceInfo() {
+            /* Find a service info without a name. */
             for (auto &service_info : g_service_list) {
-                if (service_info.name == service_name) {
+                if (service_info.name == InvalidServiceName) {
                     return std::addressof(service_info);
                 }
             }
@@ -319,8 +461,19 @@ namespace ams::sm::impl {
             return nullptr;
         }
 
-        ServiceInfo *GetFreeServiceInfo() {
-            return GetServiceInfo(InvalidServiceName);
+        void SetServiceName(ServiceInfo *service_info, ServiceName name) {
+            const size_t index = service_info - g_service_list.data();
+
+            /* Update the index. */
+            if (service_info->name != InvalidServiceName) {
+                g_service_index.Erase(GetIndexKey(service_info->name), index);
+            }
+            if (name != InvalidServiceName) {
+                g_service_index.Insert(GetIndexKey(name), index);
+            }
+
+            /* Set the name. */
+            service_info->name = name;
         }
 
         bool HasServiceInfo(ServiceName service) {
@@ -493,7 +646,7 @@ namespace ams::sm::impl {
             R_TRY(CreatePortImpl(out, std::addressof(free_service->port_h), max_sessions, is_light, free_service->name));
 
             /* Save info. */
-            free_service->name             = service;
+            SetServiceName(free_service, service);
             free_service->owner_process_id = process_id;
             free_service->max_sessions     = max_sessions;
             free_service->is_light         = is_light;
@@ -512,6 +665,7 @@ namespace ams::sm::impl {
             os::CloseNativeHandle(service_info->port_h);
 
             /* Reset the info's state. */
+            SetServiceName(service_info, InvalidServiceName);
             *service_info = InvalidServiceInfo;
 
             /* Reset the mitm info, if necessary. */
@@ -561,7 +715,7 @@ namespace ams::sm::impl {
         R_TRY(ValidateAccessControl(AccessControlEntry(acid_sac, acid_sac_size), AccessControlEntry(aci_sac, aci_sac_size)));
 
         /* Save info. */
-        proc->process_id          = process_id;
+        SetProcessId(proc, process_id);
         proc->program_id          = program_id;
         proc->override_status     = override_status;
         proc->access_control_size = aci_sac_size;
@@ -579,6 +733,7 @@ namespace ams::sm::impl {
         R_UNLESS(proc != nullptr, sm::ResultInvalidClient());
 
         /* Free the process. */
+        SetProcessId(proc, os::InvalidProcessId);
         *proc = InvalidProcessInfo;
 
         return ResultSuccess();
@@ -954,6 +1109,12 @@ namespace ams::sm::impl {
             TriggerResume(service_name);
         }
 
+        /* Log the lookup statistics accumulated during boot. */
+        if (!had_ended_defers) {
+            LogLookupStatistics("process", g_process_index.GetStatistics());
+            LogLookupStatistics("service", g_service_index.GetStatistics());
+        }
+
         return ResultSuccess();
     }
 
@@ -155,4 +155,8 @@ Result amssuHasPreparedUpdate(bool *out) {
 
 Result amssuApplyPreparedUpdate() {
     return serviceDispatch(&g_amssuSrv, 7);
+}
+
+Result amssuGetPrepareUpdateThroughput(AmsSuPrepareUpdateThroughput *out) {
+    return serviceDispatchOut(&g_amssuSrv, 8, *out);
 }
\ No newline at end of file
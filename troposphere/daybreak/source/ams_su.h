@@ -34,6 +34,18 @@ typedef struct {
     NcmContentId invalid_content_id;
 } AmsSuUpdateValidationInfo;
 
+typedef struct {
+    s64 size;
+    s64 elapsed_time_ns;
+} AmsSuStageThroughput;
+
+typedef struct {
+    AmsSuStageThroughput total;
+    AmsSuStageThroughput read;
+    AmsSuStageThroughput hash;
+    AmsSuStageThroughput write;
+} AmsSuPrepareUpdateThroughput;
+
 Result amssuInitialize();
 void   amssuExit();
 Service *amssuGetServiceSession(void);
@@ -46,6 +58,7 @@ Result amssuRequestPrepareUpdate(AsyncResult *a);
 Result amssuGetPrepareUpdateProgress(NsSystemUpdateProgress *out);
 Result amssuHasPreparedUpdate(bool *out);
 Result amssuApplyPreparedUpdate();
+Result amssuGetPrepareUpdateThroughput(AmsSuPrepareUpdateThroughput *out);
 
 #ifdef __cplusplus
 }